@@ -25,7 +25,8 @@
 /** \file Rocin.h
  *  Rocin creates a series of Roccom windows by reading in a list of files.
  *  Rocin can also copy Roccom attributes from window to window.
- *  Only HDF4 files are supported in the current implementation.
+ *  HDF4 and CGNS files are supported, as well as the shared HDF5 files
+ *  written by Rocout when built with HDF5.
  */
 /*  Author John Norris
  *  Initial date:   March 19, 2004
@@ -40,6 +41,9 @@
 #ifndef _ROCIN_H_
 #define _ROCIN_H_
 
+#include <set>
+#include <string>
+#include <vector>
 #include "roccom.h"
 #include "HDF4.h"
 #include "rocin_block.h"
@@ -64,7 +68,11 @@ extern "C" void Rocin_unload_module( const char *name);
 class Rocin : public COM_Object {
 public:
   /// Default constructor
-  Rocin() : m_is_local( NULL), m_base(0), m_offset(0) {}
+  Rocin() : m_is_local( NULL), m_base(0), m_offset(0), m_mmap("off"),
+            m_scan("root"), m_lazy("off"), m_distribute("control") {}
+
+  /// Destructor, which frees the blocks kept for deferred loading.
+  ~Rocin();
 
   /// Pointer to a function to determine locality of a pane.
   typedef void (*RulesPtr)(const int &pane_id, const int &comm_rank,
@@ -182,6 +190,65 @@ void read_parameter_file( const char* file_name,
                           const char* window_name, 
                           const MPI_Comm *comm = NULL);
 
+  /** Set an option for Rocin. The option "mmap" selects how the arrays
+   *  of native binary files are loaded: "off" (default) copies them into
+   *  arrays allocated by Roccom, reading the files ahead; "on" maps the
+   *  files privately and registers the arrays in place, so that pages
+   *  are read when first accessed and changes are not written back;
+   *  "const" maps the files read-only and registers the arrays as
+   *  constant. Mapped arrays cannot be enlarged, e.g. with ghost items,
+   *  and their files are unmapped when their windows or panes are
+   *  deleted.
+   *  The option "scan" selects who finds and scans the files read by
+   *  read_windows: with "root" (default), process 0 does it and
+   *  broadcasts the index of the blocks if all processes were given the
+   *  same patterns; with "all", every process does it.
+   *  With the option "lazy" set to "on" (default "off"), read_windows
+   *  reads the mesh, the window and pane attributes of HDF4 and CGNS
+   *  files, but only registers the nodal and elemental attributes; each
+   *  of them is read for all local panes by the first obtain_attribute
+   *  on it, on its window's "all" or "atts", or on one of its components.
+   *  Calling obtain_attribute with the same source and destination just
+   *  loads the data in place. The option "prefetch" lists the attributes
+   *  that are still read right away, separated by spaces.
+   *  The option "distribute" selects how the panes are assigned to the
+   *  processes. With "control" (default), read_by_control_file uses the
+   *  @Proc sections of the control file, and read_windows the given rule.
+   *  With "greedy" or "metis", both ignore them and weigh each pane by
+   *  its numbers of nodes and elements, and each pair of panes by the
+   *  nodes they share according to pconn; the panes then go to the least
+   *  loaded processes, preferring those with their neighbors, or to the
+   *  parts of a partition by METIS. read_by_control_file reads the files
+   *  of all @Proc sections, so that a restart on another number of
+   *  processes is balanced as well. Shared HDF5 files are then split in
+   *  contiguous ranges of panes.
+   *
+   * \param option_name the option name.
+   * \param option_val the option value.
+   */
+  void set_option( const char* option_name, const char* option_val);
+
+  /** Write the index of the blocks of an HDF4 (or CGNS) file into the
+   *  file of the same name with index_suffix() appended. read_windows
+   *  reads the index instead of scanning the file as long as the file
+   *  keeps its size, modification time and inode. With the option
+   *  "index" on, Rocout calls this once the dump of the file is complete,
+   *  since the file is scanned in full.
+   */
+  static void write_index(const std::string& file);
+
+  /** Write the index of a copy of a file, e.g. on another file system,
+   *  from the index of the file, if that is up to date. The paths of the
+   *  file and of the files in its directory, such as its mesh file, are
+   *  replaced by those in the directory of the copy, and the index is
+   *  stamped with the copy. Return false if there is no such index or
+   *  it could not be written.
+   */
+  static bool copy_index(const std::string& file, const std::string& copy);
+
+  /// Suffix of the name of the index of a file.
+  static const char* index_suffix() { return ".idx"; }
+
   //\}
 
 protected:
@@ -200,6 +267,23 @@ protected:
   void blockcyclic_local(const int& pid, const int& comm_rank,
                          const int& comm_size, int* il);
 
+  /// Local panes as assigned by balance_panes or read_windows_native.
+  void balanced_local(const int& pid, const int& comm_rank,
+                      const int& comm_size, int* il);
+
+  /** Assign the panes of the given blocks to the processes by their
+   *  sizes and the nodes they share, as selected by the option
+   *  "distribute". The pconn of the panes is read by all processes
+   *  together, each reading a share of them.
+   */
+  void balance_panes(BlockMM_HDF4::iterator hdf4,
+                     const BlockMM_HDF4::iterator& hdf4End,
+#ifdef USE_CGNS
+                     BlockMM_CGNS::iterator cgns,
+                     const BlockMM_CGNS::iterator& cgnsEnd,
+#endif // USE_CGNS
+                     const MPI_Comm* comm, int rank, int nprocs);
+
   void register_panes(BlockMM_HDF4::iterator hdf4,
                       const BlockMM_HDF4::iterator& hdf4End,
 #ifdef USE_CGNS
@@ -211,6 +295,107 @@ protected:
 
   //\}
 
+  /** \name Lazy loading
+   *  \{
+   */
+  /// Blocks of a window whose nodal and elemental data are deferred.
+  struct Lazy_window {
+    unsigned long serial;           ///< Serial number of the window
+                                    ///< created by read_windows.
+    BlockMM_HDF4 blocks_HDF4;       ///< Copies of its local HDF4 blocks.
+#ifdef USE_CGNS
+    BlockMM_CGNS blocks_CGNS;       ///< Copies of its local CGNS blocks.
+#endif // USE_CGNS
+    std::set<std::string> pending;  ///< Attributes not read yet.
+  };
+
+  /** Keep copies of the local blocks of a new window and the names of
+   *  its nodal and elemental attributes that are not prefetched. The
+   *  names of the attributes to read right away are returned in eager.
+   */
+  void defer_attributes(BlockMM_HDF4::iterator hdf4,
+                        const BlockMM_HDF4::iterator& hdf4End,
+#ifdef USE_CGNS
+                        BlockMM_CGNS::iterator cgns,
+                        const BlockMM_CGNS::iterator& cgnsEnd,
+#endif // USE_CGNS
+                        const std::string& window,
+                        std::set<std::string>& eager);
+
+  /// Read the deferred data of the given attribute, if any.
+  void load_deferred(const COM::Attribute* attribute);
+
+  /// Drop the deferred blocks of a window.
+  void drop_deferred(const std::string& window);
+
+  /// Drop the deferred blocks of a window being deleted, in every Rocin
+  /// that has deferred blocks. Registered as a deletion hook of windows.
+  static void drop_deleted(const COM::Window* window);
+  //\}
+
+  /** \name Native binary files
+   *  \{
+   */
+  /// Separate the files with the extension ".rocb" from the others.
+  static void split_files_native(int pathc, char* pathv[],
+                                 std::vector<char*>& others,
+                                 std::vector<std::string>& files);
+
+  /** Read the headers of the blocks of the given native files, followed
+   *  by those of the mesh files that the blocks of the materials at the
+   *  requested time level refer to. Empty time selects the time level of
+   *  the first such block.
+   */
+  static void scan_files_native(const std::vector<std::string>& files,
+                                const std::set<std::string>& materials,
+                                std::string& time,
+                                std::vector<Block_native>& blocks);
+
+  /** Create the windows of the materials in the blocks of native files
+   *  found by scan_files_native, which read_windows broadcasts with the
+   *  index of the other formats. The panes are distributed as for HDF4
+   *  files. The arrays of the local panes are copied or mapped as
+   *  selected by the option "mmap"; the files of the arrays mapped in
+   *  place are unmapped when the last of their panes is deleted.
+   */
+  void read_windows_native(const std::vector<Block_native>& blocks,
+                           const std::string& window_prefix,
+                           const std::set<std::string>& materials,
+                           const MPI_Comm* comm, RulesPtr is_local,
+                           const std::string& time, int rank, int nprocs);
+
+  /** Unregister the deletion hooks that unmap the files of the arrays
+   *  in place, which are functions of this module, and forget the panes
+   *  using them. Called when the last instance of Rocin is unloaded. The
+   *  files stay mapped, since the panes may still use them.
+   */
+  static void release_native();
+  //\}
+
+#ifdef USE_HDF5
+  /** \name Shared HDF5 files
+   *  \{
+   */
+  /// Separate the files with the extension ".hdf5" from the others.
+  static void split_files_HDF5(int pathc, char* pathv[],
+                               std::vector<char*>& others,
+                               std::vector<std::string>& files);
+
+  /** Create the windows of the materials in the given HDF5 files. Each
+   *  file is opened by all processes, and the panes are distributed
+   *  using the given rule or, without one, in contiguous blocks of the
+   *  pane index, so that every process reads a contiguous range of rows.
+   *  Empty time selects the time level of the first material, which is
+   *  then returned in time.
+   */
+  void read_windows_HDF5(const std::vector<std::string>& files,
+                         const std::string& window_prefix,
+                         const std::set<std::string>& materials,
+                         const MPI_Comm* comm, RulesPtr is_local,
+                         std::string& time, int rank, int nprocs);
+  //\}
+#endif // USE_HDF5
+
 protected:  
   /** \name Initialization and finalization
    * \{
@@ -242,6 +427,13 @@ protected:
   std::set<int> m_pane_ids;
   int m_base;
   int m_offset;
+  std::string m_mmap;     ///< The option "mmap".
+  std::string m_scan;     ///< The option "scan".
+  std::string m_lazy;     ///< The option "lazy".
+  std::set<std::string> m_prefetch;  ///< The option "prefetch".
+  std::string m_distribute;          ///< The option "distribute".
+  std::map<int, int> m_pane_ranks;   ///< Ranks of the panes if balanced.
+  std::map<std::string, Lazy_window> m_deferred; ///< Lazily read windows.
 
   std::map<int32, COM_Type> m_HDF2COM;
 #ifdef USE_CGNS
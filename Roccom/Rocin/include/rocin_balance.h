@@ -0,0 +1,71 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file rocin_balance.h
+ *  Distribution of panes over processes by their sizes and the nodes
+ *  they share, used by Rocin with the option "distribute". Every process
+ *  computes the same assignment from the same metadata, so no process
+ *  has to broadcast it.
+ */
+
+#ifndef _ROCIN_BALANCE_H_
+#define _ROCIN_BALANCE_H_
+
+#include <map>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+/// Cost and shared interfaces of a pane.
+struct Pane_cost {
+  Pane_cost() : pane(0), cost(1) {}
+
+  int pane;                  ///< The pane id.
+  int cost;                  ///< Number of nodes plus number of elements.
+  std::map<int, int> shared; ///< Shared nodes per neighboring pane.
+};
+
+/** Add the numbers of nodes shared with other panes, listed in the first
+ *  block of the pconn of a pane, to pane.shared. A truncated pconn is
+ *  read as far as it goes.
+ */
+void add_shared(const int* pconn, int n, Pane_cost& pane);
+
+/** Merge the interfaces found by all processes of comm into the panes of
+ *  every process. All processes must list the same panes in the same
+ *  order.
+ */
+void exchange_shared(std::vector<Pane_cost>& panes, MPI_Comm comm);
+
+/** Assign the panes to nparts processes, and return the rank of each
+ *  pane id in ranks. With the method "metis", the graph of the panes,
+ *  with the costs as vertex weights and the numbers of shared nodes as
+ *  edge weights, is partitioned by METIS. With "greedy", the panes are
+ *  taken by decreasing cost, and each goes to the least loaded process
+ *  or, among the processes loaded within 5% of the average load above
+ *  it, to the one sharing the most nodes with the pane.
+ */
+void partition_panes(const std::vector<Pane_cost>& panes, int nparts,
+                     const std::string& method, std::map<int, int>& ranks);
+
+#endif
@@ -26,6 +26,7 @@
 #define _ROCIN_BLOCK_H_
 
 #include <map>
+#include "rocin_native.h"
 
 /**
  ** Struct containing necessary information about an attribute in a window.
@@ -101,6 +102,26 @@ struct Block_HDF4 {
 };
 typedef std::multimap<std::string, Block_HDF4*> BlockMM_HDF4;
 
+/**
+ ** Metadata of a block of a native file, i.e. of some attributes of a pane.
+ **/
+struct Block_native {
+  Block_native() : offset(0), mesh(false) {}
+
+  std::string file;
+  long long offset;                ///< Offset of the block in the file.
+  Native_block header;
+  std::string material;
+  std::string time;
+  std::string mfile;               ///< Path of the mesh file, or empty.
+  bool mesh;                       ///< Whether it is in such a mesh file.
+  std::vector<Native_array> arrays;
+  std::vector<std::string> names;
+  std::vector<std::string> units;
+  std::vector<std::string> files;  ///< Files holding the data of the arrays.
+  std::vector<long long> offsets;  ///< Offsets of the data in the files.
+};
+
 #ifdef USE_CGNS
 
 /**
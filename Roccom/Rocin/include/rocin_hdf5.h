@@ -0,0 +1,78 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file rocin_hdf5.h
+ *  Layout of the shared HDF5 files written by Rocout and read by Rocin.
+ *
+ *  A file holds one group per material (window). Each group has the
+ *  string attribute "time", an optional string attribute "mesh_file"
+ *  naming the file that holds the mesh, and the datasets
+ *    - "panes": the ids of all panes of the window, ordered by the rank
+ *      of the process that wrote them;
+ *    - "pane_info": one row of HDF5_PANE_INFO_SIZE integers per pane.
+ *  Every attribute and connectivity table of the window is a subgroup
+ *  named after it (e.g. "nc", ":t3:", "pressure"), holding the integer
+ *  attributes "location", "type" and "ncomp", the string attribute
+ *  "unit", and the datasets
+ *    - "items": one row {nitems, nghost, has_data} per pane;
+ *    - "data": the items of all panes, one after the other in the order
+ *      of "panes", with one column per component.
+ *  Window attributes have a single row in "items". The names of the
+ *  connectivity tables start with ':'; their items are the elements and
+ *  their columns the nodes of each element.
+ */
+
+#ifndef _ROCIN_HDF5_H_
+#define _ROCIN_HDF5_H_
+
+#include "roccom.h"
+#include <hdf5.h>
+
+/// Columns of the dataset "pane_info".
+enum { HDF5_NNODES, HDF5_NGNODES, HDF5_STDIM, HDF5_SIZE_I, HDF5_SIZE_J,
+       HDF5_SIZE_K, HDF5_NGLAYERS, HDF5_PANE_INFO_SIZE };
+
+/// Columns of the datasets "items".
+enum { HDF5_NITEMS, HDF5_NGITEMS, HDF5_HAS_DATA, HDF5_ITEMS_SIZE };
+
+/// Return the native HDF5 type for a Roccom data type, or -1 if the
+/// data type cannot be stored.
+inline hid_t comtype2hdf5type( COM_Type type) {
+  switch ( type) {
+  case COM_CHAR:           return H5T_NATIVE_CHAR;
+  case COM_BYTE:           return H5T_NATIVE_SCHAR;
+  case COM_UNSIGNED_CHAR:  return H5T_NATIVE_UCHAR;
+  case COM_SHORT:          return H5T_NATIVE_SHORT;
+  case COM_UNSIGNED_SHORT: return H5T_NATIVE_USHORT;
+  case COM_INT:            return H5T_NATIVE_INT;
+  case COM_UNSIGNED:       return H5T_NATIVE_UINT;
+  case COM_LONG:           return H5T_NATIVE_LONG;
+  case COM_UNSIGNED_LONG:  return H5T_NATIVE_ULONG;
+  case COM_FLOAT:          return H5T_NATIVE_FLOAT;
+  case COM_DOUBLE:         return H5T_NATIVE_DOUBLE;
+  case COM_LONG_DOUBLE:    return H5T_NATIVE_LDOUBLE;
+  default:                 return -1;
+  }
+}
+
+#endif
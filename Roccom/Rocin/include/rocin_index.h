@@ -0,0 +1,121 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file rocin_index.h
+ *  Buffer for the index of the blocks of the files read by Rocin, which
+ *  process 0 broadcasts after scanning the files, and which is kept in
+ *  the index files written by Rocin::write_index.
+ */
+
+#ifndef _ROCIN_INDEX_H_
+#define _ROCIN_INDEX_H_
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <mpi.h>
+
+/// Buffer holding the block index of read_windows for broadcasting, or
+/// for the index files written by Rocin::write_index.
+class Index_buffer {
+public:
+  Index_buffer() : m_pos(0), m_ok(true) {}
+
+  template <class T>
+  void put(const T& x)
+  { const char* p = reinterpret_cast<const char*>(&x);
+    m_data.insert(m_data.end(), p, p+sizeof(T)); }
+  void put(const std::string& s)
+  { put(int(s.size())); m_data.insert(m_data.end(), s.begin(), s.end()); }
+
+  /// Get a value, or zero past the end of the data.
+  template <class T>
+  void get(T& x)
+  { if (!has(sizeof(T))) { std::memset(&x, 0, sizeof(T)); return; }
+    std::memcpy(&x, &m_data[0] + m_pos, sizeof(T)); m_pos += sizeof(T); }
+  void get(std::string& s)
+  { int n; get(n); s.clear();
+    if (n > 0 && has(n)) { s.assign(&m_data[0] + m_pos, n); m_pos += n; } }
+
+  /// Return false if a get went past the end of the data.
+  bool ok() const { return m_ok; }
+
+  /// Return true if n more bytes can be read, or else mark the buffer bad.
+  bool has(std::size_t n)
+  { m_ok = m_ok && m_pos + n <= m_data.size(); return m_ok; }
+
+  /// Read the buffer from a file.
+  bool read(const std::string& file)
+  {
+    std::ifstream fin(file.c_str(), std::ios::binary);
+    if (!fin.is_open())
+      return false;
+    fin.seekg(0, std::ios::end);
+    m_data.resize(fin.tellg());
+    fin.seekg(0);
+    if (!m_data.empty())
+      fin.read(&m_data[0], m_data.size());
+    m_pos = 0;
+    m_ok = true;
+    return !fin.fail();
+  }
+
+  /// Write the buffer to a file, replacing it at once.
+  bool write(const std::string& file) const
+  {
+    std::string tmp = file + ".tmp";
+    std::ofstream fout(tmp.c_str(), std::ios::binary);
+    if (!m_data.empty())
+      fout.write(&m_data[0], m_data.size());
+    fout.close();
+    return !fout.fail() && rename(tmp.c_str(), file.c_str()) == 0;
+  }
+
+  /// Broadcast the buffer of the given process.
+  void broadcast(int root, MPI_Comm comm)
+  {
+    int len = m_data.size();
+    MPI_Bcast(&len, 1, MPI_INT, root, comm);
+    m_data.resize(len+1);
+    MPI_Bcast(&m_data[0], len, MPI_CHAR, root, comm);
+    m_data.resize(len);
+    m_pos = 0;
+  }
+
+private:
+  std::vector<char> m_data;
+  std::size_t m_pos;
+  bool m_ok;
+};
+
+struct Block_native;
+
+/// Append the metadata of the blocks of native files to a buffer.
+void pack_blocks(const std::vector<Block_native>& blocks, Index_buffer& buf);
+
+/// Read the blocks of native files packed by pack_blocks.
+void unpack_blocks(Index_buffer& buf, std::vector<Block_native>& blocks);
+
+#endif
@@ -0,0 +1,157 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file rocin_native.h
+ *  Layout of the native binary files written by Rocout and read by Rocin.
+ *
+ *  A file is a sequence of blocks, each holding attributes of one pane as
+ *  written by one call to Rocout; appending to a file adds blocks. A block
+ *  starts with a Native_block, followed by nattrs Native_array descriptors
+ *  and then by the string table, which holds the material, the time level,
+ *  the name of the mesh file, and the name and unit of each array, without
+ *  terminating nul characters. The arrays follow, each starting at a
+ *  multiple of NATIVE_ALIGN bytes from the start of the file, so that
+ *  a mapped file can be used in place.
+ *
+ *  The components of an attribute are stored one after the other, each
+ *  with all its items. Connectivity tables, whose names start with ':',
+ *  store the first nodes of all elements, then the second nodes, and so
+ *  on. This is the staggered layout in which Rocin creates the arrays
+ *  for the other formats. The numbers are in the byte order of the
+ *  writer, and a reader with another byte order rejects the file.
+ *
+ *  An array may be compressed with zlib, after shuffling its bytes so
+ *  that the first bytes of all items come first, then the second bytes,
+ *  and so on, which groups the slowly varying bytes of numbers. The
+ *  codec is recorded in the descriptor of the array.
+ *
+ *  An array of an incremental dump that has not changed since an earlier
+ *  dump is stored as a Native_reference to the data in the earlier file,
+ *  followed by the name of that file, relative to the directory of the
+ *  referencing file unless it is absolute. References always point to
+ *  stored data, never to other references. Every block carries a stamp
+ *  that is unique to the write that created it, and a reference records
+ *  the offset and stamp of the block holding its data, so that a
+ *  reference into a file that has since been rewritten is detected.
+ */
+
+#ifndef _ROCIN_NATIVE_H_
+#define _ROCIN_NATIVE_H_
+
+#include <cstring>
+
+/// Alignment of the blocks and arrays, in bytes.
+enum { NATIVE_ALIGN = 64 };
+
+/// Version of the layout.
+enum { NATIVE_VERSION = 2 };
+
+/// Value of the field byte_order as seen by the writer.
+enum { NATIVE_BYTE_ORDER = 0x01020304 };
+
+/// Codecs of the arrays.
+enum { NATIVE_RAW,             ///< Not compressed.
+       NATIVE_ZLIB,            ///< Compressed with zlib.
+       NATIVE_SHUFFLE_ZLIB,    ///< Shuffled, then compressed with zlib.
+       NATIVE_REFERENCE };     ///< A Native_reference to another file.
+
+/// Header of a block.
+struct Native_block {
+  char magic[8];         ///< "ROCBIN" followed by two nul characters.
+  int byte_order;        ///< NATIVE_BYTE_ORDER.
+  int version;           ///< NATIVE_VERSION.
+  long long size;        ///< Size of the block, a multiple of NATIVE_ALIGN.
+  long long meta_size;   ///< Size of the header, descriptors and strings.
+  int pane_id;
+  int nnodes;            ///< Number of nodes, including ghost nodes.
+  int ngnodes;           ///< Number of ghost nodes.
+  int stdim;             ///< Dimension of a structured mesh, or 0.
+  int size_i, size_j, size_k;
+  int nglayers;          ///< Ghost layers of a structured mesh.
+  int nattrs;            ///< Number of Native_array descriptors.
+  int material_len;
+  int time_len;
+  int mfile_len;         ///< Length of the name of the mesh file, or 0.
+  unsigned long long stamp;  ///< Unique to the write of the block.
+};
+
+/// Descriptor of an array of a block.
+struct Native_array {
+  long long offset;      ///< Offset of the data from the start of the block.
+  long long nbytes;      ///< Size of the data in the file, 0 if there is none.
+  int loc;               ///< Location of the attribute, such as 'n'.
+  int type;              ///< Roccom data type.
+  int ncomp;             ///< Components, or nodes per element.
+  int nitems;            ///< Number of items, including ghost items.
+  int ngitems;           ///< Number of ghost items.
+  int name_len;
+  int unit_len;
+  int codec;             ///< NATIVE_RAW or the codec of the data.
+};
+
+/// Reference to the data of an array in another file.
+struct Native_reference {
+  long long block;       ///< Offset of the block holding the data.
+  unsigned long long stamp;  ///< Stamp of that block.
+  long long offset;      ///< Offset of the data from the start of the file.
+  long long nbytes;      ///< Size of the data in the file.
+  int codec;             ///< Codec of the data, other than NATIVE_REFERENCE.
+  int path_len;          ///< Length of the name of the file that follows.
+};
+
+/// Set the magic string of a block.
+inline void native_set_magic(Native_block& b)
+{ std::memset(b.magic, 0, sizeof(b.magic)); std::memcpy(b.magic, "ROCBIN", 6); }
+
+/// Return true if a block starts with the magic string.
+inline bool native_is_block(const Native_block& b)
+{ return std::memcmp(b.magic, "ROCBIN\0\0", 8) == 0; }
+
+/// Round up an offset to a multiple of NATIVE_ALIGN.
+inline long long native_align(long long n)
+{ return (n + NATIVE_ALIGN - 1) / NATIVE_ALIGN * NATIVE_ALIGN; }
+
+/// Return true if the name of a file ends with the extension ".rocb".
+inline bool native_is_file(const char* path)
+{
+  std::size_t n = std::strlen(path);
+  return n > 5 && std::strcmp(path + n - 5, ".rocb") == 0;
+}
+
+/// Shuffle the bytes of n items of sz bytes.
+inline void native_shuffle(const char* in, char* out, std::size_t n, int sz)
+{
+  for (int b=0; b<sz; ++b)
+    for (std::size_t i=0; i<n; ++i)
+      out[b*n+i] = in[i*sz+b];
+}
+
+/// Undo native_shuffle.
+inline void native_unshuffle(const char* in, char* out, std::size_t n, int sz)
+{
+  for (int b=0; b<sz; ++b)
+    for (std::size_t i=0; i<n; ++i)
+      out[i*sz+b] = in[b*n+i];
+}
+
+#endif
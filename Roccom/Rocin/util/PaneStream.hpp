@@ -0,0 +1,540 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+/** \file PaneStream.hpp
+ * Streaming of the panes of Rocin dumps to the converters in this
+ * directory. The input files of each time level are read one at a time
+ * into their own window, and the panes of the window are handed to a
+ * pool of threads. At most one more file than there are threads is kept
+ * in memory, and the files of the next time level are read while the
+ * panes of the previous ones are still being converted.
+ *
+ * Roccom is not thread-safe, so all calls to Roccom and Rocin are made by
+ * the reading thread. It takes a Pane snapshot of the arrays of each pane,
+ * and the converting threads only see these snapshots.
+ */
+
+#ifndef _PANESTREAM_HPP_
+#define _PANESTREAM_HPP_
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#ifndef _NO_GLOB_
+#include <glob.h>
+#endif
+
+#ifdef USE_PTHREADS
+#include "Sync.h"
+#endif
+
+#include "roccom.h"
+
+namespace PaneStream {
+
+/// An attribute of a pane, with one array per component.
+struct Attr {
+  std::string name;
+  std::string units;
+  char loc;
+  int type;
+  int ncomp;
+  int nitems;   ///< Number of items in the pane, including ghosts.
+  int nghost;   ///< Number of ghost items in the pane.
+  std::vector<const void*> comps;  ///< Arrays of the components, or NULL.
+};
+
+/// An element connectivity table of an unstructured pane.
+struct Conn {
+  std::string type;  ///< Element type without the colons, e.g. "t3".
+  int nelems;        ///< Number of elements, including ghosts.
+  int nghost;        ///< Number of ghost elements.
+  const int *data;   ///< Staggered 1-based node ids.
+};
+
+/// A pane of a dump as seen by the converting threads.
+struct Pane {
+  std::string window;  ///< Name of the output window.
+  std::string time;    ///< Time level of the dump.
+  int id;              ///< Pane id.
+  int nnodes;          ///< Number of nodes, including ghosts.
+  int nghost;          ///< Number of ghost nodes.
+  int ndims;           ///< Number of dimensions of a structured pane or 0.
+  int sghost;          ///< Number of ghost layers of a structured pane.
+  int dims[3];         ///< Nodal dimensions of a structured pane.
+  std::vector<Conn> conns;  ///< Connectivity tables of unstructured panes.
+  std::vector<Attr> attrs;  ///< Attributes, starting with "nc".
+
+  bool structured() const { return ndims>0; }
+};
+
+/// Converts a pane. Called on the threads of the pool.
+typedef void (*Convert)( const Pane &pane, void *ctx);
+
+/** Called on the reading thread once all panes of a dump are converted.
+ *  The panes are sorted by their ids, and their arrays are no longer
+ *  valid. */
+typedef void (*Finish)( const std::string &window, const std::string &time,
+			const std::vector<Pane> &panes, void *ctx);
+
+/** Called on the reading thread with the panes of each input file before
+ *  they are converted, e.g., to make their attributes consistent. */
+typedef void (*Prepare)( std::vector<Pane> &panes, void *ctx);
+
+/// Options of the streaming.
+struct Options {
+  std::string input;   ///< File pattern(s), or the control file.
+  bool control;        ///< Whether input is a Rocin control file.
+  std::string window;  ///< Name of the output window.
+  std::vector<std::string> times;  ///< Time levels, or empty for the first.
+  int nthreads;        ///< Number of converting threads.
+
+  Options() : control(false), nthreads(1) {}
+};
+
+/// Default number of converting threads.
+inline int default_threads() {
+  long n = sysconf( _SC_NPROCESSORS_ONLN);
+  return n>0 ? int(n) : 1;
+}
+
+/// Name of the output window derived from the input, as Rocin's tools do.
+inline std::string window_name( const std::string &input) {
+  std::string win( input);
+  std::string::size_type st = win.find_last_of('/');
+  if (st != std::string::npos)
+    win.erase(0, st+1);
+  st = win.find_first_not_of("abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVWXYZ");
+  if (st != std::string::npos)
+    win.erase(st);
+  return win;
+}
+
+/// Append time levels given as a space-separated list.
+inline void add_times( const std::string &list,
+		       std::vector<std::string> &times) {
+  std::istringstream sin( list);
+  std::string t;
+  while ( sin >> t) times.push_back( t);
+}
+
+/** Substitute the place holders of a file pattern of a control file:
+ *  %t by the time level (or * if not known), and %p, %i and %b, with an
+ *  optional width, by as many digits. */
+inline std::string expand_pattern( const std::string &pat,
+				   const std::string &time) {
+  std::string s;
+  for ( std::string::size_type i=0; i<pat.size(); ++i) {
+    if ( pat[i] != '%') { s += pat[i]; continue; }
+    std::string::size_type j = i+1;
+    int width = 0;
+    while ( j<pat.size() && pat[j]>='0' && pat[j]<='9')
+      width = width*10 + pat[j++]-'0';
+    if ( j<pat.size() && pat[j]=='t') {
+      s += time.empty() ? std::string("*") : time;
+      i = j;
+    }
+    else if ( j<pat.size() && (pat[j]=='p' || pat[j]=='i' || pat[j]=='b')) {
+      for ( int k=0; k<(width ? width : 4); ++k) s += "[0-9]";
+      i = j;
+    }
+    else
+      s += pat[i];
+  }
+  return s;
+}
+
+/// Append the files matching a pattern.
+inline void glob_files( const std::string &pat,
+			std::vector<std::string> &files) {
+#ifndef _NO_GLOB_
+  glob_t g;
+  if ( glob( pat.c_str(), 0, NULL, &g) == 0) {
+    for ( size_t i=0; i<g.gl_pathc; ++i) files.push_back( g.gl_pathv[i]);
+  }
+  globfree( &g);
+#else
+  std::ifstream f( pat.c_str());
+  if ( f) files.push_back( pat);
+#endif
+}
+
+/** Obtain the input files of a time level, either from the file patterns
+ *  or from the @Files section of a control file. */
+inline std::vector<std::string> input_files( const Options &opt,
+					     const std::string &time) {
+  std::vector<std::string> pats;
+  if ( opt.control) {
+    std::ifstream f( opt.input.c_str());
+    if ( !f) {
+      std::cerr << "Rocstar: Error: Cannot open control file "
+		<< opt.input << std::endl;
+      exit( -1);
+    }
+    std::string dir;
+    std::string::size_type st = opt.input.find_last_of('/');
+    if ( st != std::string::npos) dir = opt.input.substr( 0, st+1);
+
+    std::string tok;
+    bool in_files = false;
+    while ( f >> tok) {
+      if ( tok[0] == '@') { in_files = (tok == "@Files:"); continue; }
+      if ( !in_files) continue;
+      std::string pat = expand_pattern( tok, time);
+      // Prepend the directory of the control file, as Rocin does.
+      if ( pat[0] != '/' && pat.compare( 0, dir.size(), dir) != 0)
+	pat.insert( 0, dir);
+      pats.push_back( pat);
+    }
+  }
+  else {
+    std::istringstream sin( opt.input);
+    std::string tok;
+    while ( sin >> tok) pats.push_back( expand_pattern( tok, time));
+  }
+
+  std::vector<std::string> files;
+  for ( int i=0, n=pats.size(); i<n; ++i) glob_files( pats[i], files);
+  std::sort( files.begin(), files.end());
+  files.erase( std::unique( files.begin(), files.end()), files.end());
+  return files;
+}
+
+/// Take snapshots of the panes of a window.
+inline void snapshot( const std::string &wname, const std::string &window,
+		      const std::string &time, std::vector<Pane> &panes) {
+  int npanes, *pane_ids;
+  COM_get_panes( wname.c_str(), &npanes, &pane_ids);
+
+  int nattrs; char *attr_str;
+  COM_get_attributes( wname.c_str(), &nattrs, &attr_str);
+
+  std::vector<Attr> attrs( 1);
+  attrs[0].name = "nc";
+  {
+    std::istringstream sin( attr_str);
+    std::string name;
+    while ( sin >> name) {
+      Attr a; a.name = name;
+      attrs.push_back( a);
+    }
+  }
+  for ( int i=0, n=attrs.size(); i<n; ++i)
+    COM_get_attribute( (wname+'.'+attrs[i].name).c_str(), &attrs[i].loc,
+		       &attrs[i].type, &attrs[i].ncomp, &attrs[i].units);
+
+  panes.resize( npanes);
+  for ( int i=0; i<npanes; ++i) {
+    Pane &p = panes[i];
+    p.window = window; p.time = time; p.id = pane_ids[i];
+    p.ndims = p.sghost = 0;
+    p.dims[0] = p.dims[1] = p.dims[2] = 1;
+    COM_get_size( (wname+".nc").c_str(), p.id, &p.nnodes, &p.nghost);
+
+    int nconn; char *conn_names;
+    COM_get_connectivities( wname.c_str(), p.id, &nconn, &conn_names);
+    std::istringstream sin( conn_names);
+    std::string cname;
+    while ( sin >> cname) {
+      std::string name = wname + '.' + cname;
+      if ( cname.compare( 0, 3, ":st") == 0) {
+	const int *dims;
+	COM_get_size( name.c_str(), p.id, &p.ndims, &p.sghost);
+	COM_get_array_const( name.c_str(), p.id, &dims);
+	for ( int k=0; k<p.ndims && k<3; ++k) p.dims[k] = dims[k];
+	continue;
+      }
+      Conn c;
+      c.type = cname.substr( 1, cname.find( ':', 2)-1);
+      COM_get_size( name.c_str(), p.id, &c.nelems, &c.nghost);
+      COM_get_array_const( name.c_str(), p.id, &c.data);
+      p.conns.push_back( c);
+    }
+    COM_free_buffer( &conn_names);
+
+    for ( int k=0, n=attrs.size(); k<n; ++k) {
+      if ( attrs[k].loc == 'w') continue;
+      Attr a = attrs[k];
+      std::string name = wname + '.' + a.name;
+      COM_get_size( name.c_str(), p.id, &a.nitems, &a.nghost);
+      a.comps.assign( a.ncomp, (const void*)NULL);
+      if ( a.ncomp == 1)
+	COM_get_array_const( name.c_str(), p.id, &a.comps[0]);
+      else {
+	for ( int c=0; c<a.ncomp; ++c) {
+	  std::ostringstream sout;
+	  sout << wname << '.' << c+1 << '-' << a.name;
+	  COM_get_array_const( sout.str().c_str(), p.id, &a.comps[c]);
+	}
+      }
+      p.attrs.push_back( a);
+    }
+  }
+
+  COM_free_buffer( &pane_ids);
+  COM_free_buffer( &attr_str);
+}
+
+/// Strip the arrays from a snapshot, keeping the sizes.
+inline Pane strip( const Pane &p) {
+  Pane s = p;
+  for ( int i=0, n=s.conns.size(); i<n; ++i) s.conns[i].data = NULL;
+  for ( int i=0, n=s.attrs.size(); i<n; ++i)
+    s.attrs[i].comps.assign( s.attrs[i].ncomp, (const void*)NULL);
+  return s;
+}
+
+inline bool by_id( const Pane &a, const Pane &b) { return a.id < b.id; }
+
+/// The panes of one input file, converted on the pool.
+struct Batch {
+  std::string wname;       ///< Roccom window holding the file.
+  int dump;                ///< Index of the dump the file belongs to.
+  int pending;             ///< Number of panes not yet converted.
+  std::vector<Pane> panes;
+};
+
+/// A job of the pool: one pane of a batch.
+struct Job {
+  Convert convert;
+  void *ctx;
+  Batch *batch;
+  const Pane *pane;
+};
+
+/** A fixed set of threads converting panes. Without USE_PTHREADS, the
+ *  panes are converted by the calling thread on submission. */
+class Pool {
+public:
+  explicit Pool( int nthreads)
+#ifdef USE_PTHREADS
+    : _work( _mutex), _done( _mutex), _stop( false)
+#endif
+  {
+#ifdef USE_PTHREADS
+    for ( int i=0; i<nthreads; ++i) {
+      pthread_t t;
+      if ( pthread_create( &t, NULL, &Pool::run, this) == 0)
+	_threads.push_back( t);
+    }
+#endif
+  }
+
+  ~Pool() {
+#ifdef USE_PTHREADS
+    _mutex.Lock();
+    _stop = true;
+    _work.Broadcast();
+    _mutex.Unlock();
+    for ( int i=0, n=_threads.size(); i<n; ++i)
+      pthread_join( _threads[i], NULL);
+#endif
+  }
+
+  /// Queue the conversion of a pane of a batch.
+  void submit( const Job &job) {
+#ifdef USE_PTHREADS
+    if ( !_threads.empty()) {
+      _mutex.Lock();
+      _jobs.push_back( job);
+      _work.Signal();
+      _mutex.Unlock();
+      return;
+    }
+#endif
+    job.convert( *job.pane, job.ctx);
+    --job.batch->pending;
+  }
+
+  /// Wait until all panes of a batch are converted.
+  void wait( Batch *b) {
+#ifdef USE_PTHREADS
+    _mutex.Lock();
+    while ( b->pending > 0) _done.Wait();
+    _mutex.Unlock();
+#endif
+  }
+
+  /// Whether all panes of a batch are converted.
+  bool done( Batch *b) {
+#ifdef USE_PTHREADS
+    _mutex.Lock();
+    bool d = b->pending == 0;
+    _mutex.Unlock();
+    return d;
+#else
+    return b->pending == 0;
+#endif
+  }
+
+private:
+#ifdef USE_PTHREADS
+  static void *run( void *arg) {
+    Pool *pool = (Pool*)arg;
+    pool->_mutex.Lock();
+    for (;;) {
+      while ( pool->_jobs.empty() && !pool->_stop) pool->_work.Wait();
+      if ( pool->_jobs.empty()) break;
+      Job job = pool->_jobs.front();
+      pool->_jobs.pop_front();
+      pool->_mutex.Unlock();
+
+      job.convert( *job.pane, job.ctx);
+
+      pool->_mutex.Lock();
+      if ( --job.batch->pending == 0) pool->_done.Broadcast();
+    }
+    pool->_mutex.Unlock();
+    return NULL;
+  }
+
+  Mutex _mutex;
+  Condition _work;   // Signaled when jobs are queued or on shutdown.
+  Condition _done;   // Signaled when a batch is completed.
+  bool _stop;
+  std::deque<Job> _jobs;
+  std::vector<pthread_t> _threads;
+#endif
+};
+
+/// The panes of one time level.
+struct Dump {
+  std::string time;
+  std::vector<Pane> panes;  ///< Stripped panes of the completed batches.
+  int open;                 ///< Number of batches not yet completed.
+  bool all_read;            ///< Whether all files have been read.
+};
+
+/** Retire the completed batches at the front of the queue, waiting for
+ *  them while more than max_inflight batches are queued. Deletes their
+ *  windows, and finishes the dumps whose batches are all completed. */
+inline void retire( Pool &pool, std::deque<Batch*> &inflight,
+		    std::vector<Dump> &dumps, int max_inflight,
+		    const std::string &window, Finish finish, void *ctx) {
+  while ( !inflight.empty()) {
+    Batch *b = inflight.front();
+    if ( int(inflight.size()) > max_inflight) pool.wait( b);
+    else if ( !pool.done( b)) break;
+
+    Dump &d = dumps[b->dump];
+    for ( int i=0, n=b->panes.size(); i<n; ++i)
+      d.panes.push_back( strip( b->panes[i]));
+    COM_delete_window( b->wname.c_str());
+    inflight.pop_front();
+    delete b;
+
+    if ( --d.open == 0 && d.all_read) {
+      std::sort( d.panes.begin(), d.panes.end(), by_id);
+      finish( window, d.time, d.panes, ctx);
+      d.panes.clear();
+    }
+  }
+}
+
+/** Convert the panes of the dumps of all requested time levels. Each
+ *  pane is passed to convert on a thread of the pool, and finish is
+ *  called for each dump, in the order of the time levels, once all its
+ *  panes are converted. If given, prepare is called for the panes of each
+ *  file before they are converted. Returns the time levels of the dumps. */
+inline std::vector<std::string> run( const Options &opt, Convert convert,
+				     Finish finish, void *ctx,
+				     Prepare prepare = NULL) {
+  int IN_read = COM_get_function_handle("IN.read_window");
+  int IN_obtain = COM_get_function_handle("IN.obtain_attribute");
+
+  std::vector<Dump> dumps;
+  std::deque<Batch*> inflight;
+  Pool pool( opt.nthreads);
+  int nread = 0;
+
+  std::vector<std::string> times = opt.times;
+  if ( times.empty()) times.push_back( "");
+
+  for ( int t=0, nt=times.size(); t<nt; ++t) {
+    Dump dump;
+    dump.time = times[t]; dump.open = 0; dump.all_read = false;
+    dumps.push_back( dump);
+    const int di = dumps.size()-1;
+
+    std::vector<std::string> files = input_files( opt, times[t]);
+    if ( files.empty())
+      std::cerr << "Rocstar: Warning: No input files for time level "
+		<< (times[t].empty() ? std::string("(first)") : times[t])
+		<< std::endl;
+
+    for ( int i=0, n=files.size(); i<n; ++i) {
+      // Keep at most one file more than there are threads in memory.
+      retire( pool, inflight, dumps, opt.nthreads, opt.window, finish, ctx);
+
+      std::ostringstream wname;
+      wname << opt.window << "_stream" << nread++;
+
+      // Read the other files of a dump at the time level of the first.
+      char time_level[33];
+      std::strncpy( time_level, dumps[di].time.c_str(), sizeof(time_level));
+      time_level[sizeof(time_level)-1] = '\0';
+      int len = sizeof(time_level)-1;
+      COM_call_function( IN_read, files[i].c_str(), wname.str().c_str(),
+			 NULL, NULL, time_level, &len);
+      // Files without panes at the time level yield no window.
+      if ( COM_get_window_handle( wname.str().c_str()) < 0) continue;
+      if ( dumps[di].time.empty()) dumps[di].time = time_level;
+
+      int IN_all = COM_get_attribute_handle( (wname.str()+".all").c_str());
+      COM_call_function( IN_obtain, &IN_all, &IN_all);
+
+      Batch *b = new Batch;
+      b->wname = wname.str(); b->dump = di;
+      snapshot( b->wname, opt.window, dumps[di].time, b->panes);
+      if ( prepare) prepare( b->panes, ctx);
+      b->pending = b->panes.size();
+      ++dumps[di].open;
+      inflight.push_back( b);
+
+      for ( int k=0, nk=b->panes.size(); k<nk; ++k) {
+	Job job = { convert, ctx, b, &b->panes[k] };
+	pool.submit( job);
+      }
+    }
+
+    dumps[di].all_read = true;
+    if ( dumps[di].open == 0 && !files.empty())
+      finish( opt.window, dumps[di].time, dumps[di].panes, ctx);
+  }
+  retire( pool, inflight, dumps, 0, opt.window, finish, ctx);
+
+  std::vector<std::string> done;
+  for ( int i=0, n=dumps.size(); i<n; ++i) done.push_back( dumps[i].time);
+  return done;
+}
+
+} // namespace PaneStream
+
+#endif
@@ -32,24 +32,81 @@ MAP_BEGIN_NAMESPACE
 
 /// Constructs the dual connectivity for the whole pane (including ghost
 /// nodes and elements), which contains information about
-/// incident elements for each node.
+/// incident elements for each node. The incident elements are stored 
+/// in compressed-row form: those of node i (starting from 1) are 
+/// element_ids()[offsets()[i-1]] to element_ids()[offsets()[i]-1].
 class Pane_dual_connectivity {
 public:
   /// Constructs the dual connectivity for a given pane.
   explicit Pane_dual_connectivity( const COM::Pane *p, bool with_ghost=true);
 
+  /** Obtain the dual connectivity of a pane from a cache shared by all
+   *  modules. It is recomputed only if the mesh generation of the pane 
+   *  has changed (see COM::Pane::mesh_generation), so a connectivity 
+   *  modified in place must be marked by COM::Pane::mesh_changed. The 
+   *  reference is valid until the next call to get, build or invalidate 
+   *  for the pane or until the pane is deleted. Copies of the pane, even 
+   *  with the same window name and pane ID, have entries of their own. 
+   *  The cache is locked, but the caller must not rebuild the entry of a
+   *  pane in one thread while using it in another. */
+  static const Pane_dual_connectivity &get( const COM::Pane *p, 
+					    bool with_ghost=true);
+
+  /// Bring the cached dual connectivities of the given panes up to date, 
+  /// constructing them concurrently if pthreads are available.
+  static void build( const std::vector<const COM::Pane*> &panes, 
+		     bool with_ghost=true);
+
+  /// Remove the cached dual connectivities of a pane. It is called 
+  /// automatically when a pane is deleted.
+  static void invalidate( const COM::Pane *p);
+
+  /// Remove all cached dual connectivities and unregister invalidate, 
+  /// which is a function of this module. It is called when Rocmap is 
+  /// unloaded.
+  static void release_caches();
+
   /// Obtain the IDs of the elements incident on a given node
-  void incident_elements( int node_id, std::vector<int>& elists);
+  void incident_elements( int node_id, std::vector<int>& elists) const;
+
+  /// Obtain the number of elements incident on a given node
+  int size_of_incident_elements( int node_id) const
+  { return _offsets[node_id]-_offsets[node_id-1]; }
+
+  /// Obtain the first of the elements incident on a given node
+  const int *begin_incident_elements( int node_id) const
+  { return &_eids[0]+_offsets[node_id-1]; }
+
+  /// Obtain the end of the elements incident on a given node
+  const int *end_incident_elements( int node_id) const
+  { return &_eids[0]+_offsets[node_id]; }
+
+  /// The offsets in element_ids() for all nodes (size #nodes+1).
+  const std::vector<int> &offsets() const { return _offsets; }
+
+  /// The incident element ids for all nodes.
+  const std::vector<int> &element_ids() const { return _eids; }
 
 protected:
+  /// Constructor for the cache, which defers the construction.
+  Pane_dual_connectivity( const COM::Pane *p, bool with_ghost, 
+			  unsigned long version)
+    : _pane(*p), _with_ghost(with_ghost), _version(version) {}
+
+  /// Construct dual connectivity for the pane
+  void construct_connectivity();
   /// Construct dual connectivity for 2-D structured meshes
   void construct_connectivity_str_2();
   /// Construct dual connectivity for unstructured meshes
   void construct_connectivity_unstr();
 
+  /// Construct the ith of a vector of cached dual connectivities.
+  static void build_entry( void *dcs, int i);
+
 private:
   const COM::Pane     &_pane;      // Pane object
   bool                 _with_ghost;// Whether to include ghost nodes/elements
+  unsigned long        _version;   // Mesh generation of the pane
   std::vector< int>    _offsets;   // The offsets in _eids for each node
   std::vector< int>    _eids;      // The incident element ids for all nodes
 };
@@ -36,6 +36,13 @@
 #include "commpi.h"
 #include "roccom_assertion.h"
 
+// MPI-3 neighborhood collectives are needed for the COMM_NEIGHBOR backend,
+// and MPI-3 shared-memory windows for the COMM_SHM backend.
+#if !defined(DUMMY_MPI) && defined(MPI_VERSION) && MPI_VERSION >= 3
+#define MAP_NEIGHBOR_COLLECTIVES 1
+#define MAP_SHARED_MEMORY 1
+#endif
+
 MAP_BEGIN_NAMESPACE
 
 /// Encapsulates information about distribution of panes on all processes
@@ -53,15 +60,43 @@ protected:
   /// outbuf.
   struct Pane_comm_buffers {
     // Default constructor
-    Pane_comm_buffers() : rank(-1), tag(-1), index(-1) {}
+    Pane_comm_buffers() : rank(-1), tag(-1), index(-1), 
+			  peer_pane(-1), peer_buf(-1), 
+			  shm_send_offset(-1), shm_recv_offset(-1) {}
 
     int                   rank;   // rank for communicating process
     int                   tag;    // tag for MPI message
     int                   index;  // starting index of information 
                                   // between the two panes in the 
                                   // pconn of the local pane
+    int                   peer_pane;  // index of the communicating pane
+                                      // if it is local, or -1
+    int                   peer_buf;   // index of the matching buffer of
+                                      // the communicating pane
+    int                   shm_send_offset; // byte offsets of outgoing
+    int                   shm_recv_offset; // and incoming messages in the
+                                           // shared segment of the sending
+                                           // process, or -1
     std::vector< char>    outbuf; // buffer for outgoing messages
     std::vector< char>    inbuf;  // buffer for incoming messages
+    std::vector< char>    wirebuf;// buffer for incoming messages in a
+                                  // reduced-precision wire format
+    std::vector< double>  send_ref; // values last sent and received with
+    std::vector< double>  recv_ref; // WIRE_DELTA, as seen by the receiver
+    std::vector< int>     ref_slots; // slots of the shared nodes sent to 
+                                     // another process in the Shared_refs
+                                     // of the pane, which replace send_ref
+  };
+
+  /// The values of the shared nodes of a local pane that are sent to other
+  /// processes, as the receivers reconstruct them with WIRE_DELTA_FLOAT.
+  /// They are kept once for each node rather than for each message, so 
+  /// that a node is rounded once and all its messages carry the same 
+  /// difference.
+  struct Shared_refs {
+    std::vector< int>     nodes;  // the nodes, in increasing order
+    std::vector< double>  ref;    // their values as last reconstructed
+    std::vector< float>   delta;  // the differences sent by the update
   };
 public:
   // Note: One can use the RNS and GNR for sending and receiving data for
@@ -74,6 +109,24 @@ public:
     GCR          // Ghost cells to receive.
   };
 
+  /// Backends for messages between panes on different processes.
+  enum Comm_mode {
+    COMM_P2P,      // MPI_Isend/MPI_Irecv for each pair of panes.
+    COMM_NEIGHBOR, // One MPI_Ineighbor_alltoallv over the pconn graph.
+    COMM_SHM       // MPI-3 shared memory for processes on the same node,
+                   // and MPI_Isend/MPI_Irecv for other processes.
+  };
+
+  /// Formats of double-precision values in messages between processes.
+  /// Values are always stored and reduced in double precision.
+  enum Wire_type {
+    WIRE_NATIVE,     // The values themselves.
+    WIRE_FLOAT,      // The values rounded to single precision.
+    WIRE_DELTA_FLOAT // The differences from the values of the previous
+                     // exchange in WIRE_DELTA_FLOAT, rounded to single 
+                     // precision. The rounding errors do not accumulate.
+  };
+
   /// Constructor from a communicator.
   /// Also initialize the internal data structures of the communicator,
   /// in particular the internal pane IDs.
@@ -96,6 +149,54 @@ public:
   /// Obtain the MPI communicator for the object
   MPI_Comm mpi_comm() const { return _comm; }
 
+  /// Select the backend used by subsequent calls to init. COMM_NEIGHBOR
+  /// and COMM_SHM fall back to COMM_P2P if MPI-3 is not available. Note
+  /// that init is collective over the communicator for COMM_NEIGHBOR and
+  /// over the processes on each node for COMM_SHM. Panes on the same 
+  /// process always exchange data by direct copies.
+  void set_comm_mode( int mode);
+
+  /// Obtain the backend of the object.
+  int comm_mode() const { return _comm_mode; }
+
+  /// Select the backend for communicators constructed afterwards.
+  static void set_default_comm_mode( int mode);
+
+  /// Obtain the backend for communicators constructed afterwards.
+  static int default_comm_mode() { return _default_comm_mode; }
+
+  /// Free the MPI resources cached for all communicators, i.e., the graph
+  /// communicators of COMM_NEIGHBOR and the shared-memory windows of
+  /// COMM_SHM. It is collective over all processes and is called 
+  /// automatically by MPI_Finalize. Existing communicators must be 
+  /// initialized again with init before their next update.
+  static void release_cached_resources();
+
+  /// Release the cached resources, drop the cached pane splits and 
+  /// unregister the deletion hooks of the caches, which are functions 
+  /// of this module. It is collective over all processes and is called
+  /// when Rocmap is unloaded.
+  static void release_caches();
+
+  /// Select the format of the values in subsequent updates of this
+  /// object, which can be changed between updates and is WIRE_NATIVE
+  /// initially. It applies only to double-precision data of user-defined
+  /// attributes exchanged between processes; the mesh (e.g., coordinates
+  /// passed to init as an attribute) and other data are sent as they are.
+  /// All processes must use the same format for an update. The previous
+  /// values for WIRE_DELTA_FLOAT are kept for each pair of communicating
+  /// panes while the same arrays are updated, and are discarded when 
+  /// init is called for other arrays or another pconn. So it pays off 
+  /// only if the same object is used for repeated updates of slowly 
+  /// changing values, as in smoothing iterations. For the reductions on
+  /// shared nodes, the local values of the nodes shared with other
+  /// processes are rounded in the same way before they are reduced, so
+  /// that all copies of a node still get the same result.
+  void set_wire_type( int wire);
+
+  /// Obtain the format of the values in updates.
+  int wire_type() const { return _wire_type; }
+
   /// Obtains all the local panes.
   std::vector<COM::Pane*> &panes() { return _panes; }
 
@@ -114,6 +215,29 @@ public:
     return _lpaneid_map.find(pane_id)->second;
   }
 
+  /** @name Interior and border items of local panes
+   *  A border node is a real node that is shared with another pane or is 
+   *  incident on a border element. A border element is a real element
+   *  incident on a shared or ghost node. Interior items do not depend on
+   *  values updated by communication, so they can be processed between
+   *  begin_update_* and end_update_*. Border items should be processed
+   *  after end_update_*. The lists are 1-based, are computed from the
+   *  pconn passed to init, and are cached until the pconn or the mesh
+   *  generation of the pane changes (see COM::Pane::mesh_generation),
+   *  so a mesh modified in place must be marked by mesh_changed.
+   *  Panes must be initialized with init first.
+   *  Structured panes with ghost layers are treated as all border.
+   *  @{ */
+  const std::vector<int> &interior_elements( int i)
+  { return pane_split( i).interior_elements; }
+  const std::vector<int> &border_elements( int i)
+  { return pane_split( i).border_elements; }
+  const std::vector<int> &interior_nodes( int i)
+  { return pane_split( i).interior_nodes; }
+  const std::vector<int> &border_nodes( int i)
+  { return pane_split( i).border_nodes; }
+  //@}
+
   /// Initiates updating shared nodes by calling MPI_Isend and MPI_Irecv.
   /// If involved is not NULL, then at exit it contains a vector of bitmaps, 
   /// each of which corresponds to a local pane, and the size of each bitmap 
@@ -176,7 +300,28 @@ public:
   /// nodes, assuming begin_update_shared_nodes() has been called.
   void reduce_average_on_shared_nodes();
 
+  /// Interior and border items of a pane, cached for a pconn.
+  struct Pane_split {
+    Pane_split() : pconn(NULL), pconn_size(0), pconn_hash(0), 
+		   mesh_gen(0) {}
+
+    // Information for validating the cached lists.
+    const int           *pconn;
+    int                  pconn_size;
+    unsigned int         pconn_hash;
+    unsigned long        mesh_gen;
+
+    std::vector<int>     interior_elements, border_elements;
+    std::vector<int>     interior_nodes, border_nodes;
+  };
+
 protected:
+  /// Obtain the interior and border items of the ith local pane.
+  const Pane_split &pane_split( int i);
+
+  /// Compute the interior and border items of the ith local pane.
+  void compute_pane_split( int i, Pane_split &split);
+
   /// Initialize a Pane_comm_buffers for ghost information
   void init_pane_comm_buffers(std::vector< Pane_comm_buffers>& pcb,
 			      const int* ptr, int& index, const int n_items, const int lpid);
@@ -189,9 +334,75 @@ protected:
   void begin_update(const Buff_type btype,
 		    std::vector<std::vector<bool> > *involved=NULL);
 
+  /// Copy a message to a communicating pane on the same process.
+  void copy_to_peer( const Buff_type btype, int i, 
+		     const Pane_comm_buffers &pcb);
+
+  /// Whether a message is sent in a reduced-precision wire format.
+  bool is_encoded( const Pane_comm_buffers &pcb) const {
+    return _wire_type != WIRE_NATIVE && !_mesh_values && pcb.rank != _rank &&
+      ( _type == COM_DOUBLE || _type == COM_DOUBLE_PRECISION);
+  }
+
+  /// The number of bytes of a message of n items.
+  int message_bytes( const Pane_comm_buffers &pcb, int n) const
+  { return is_encoded( pcb) ? n*_ncomp*int(sizeof(float)) : n*_ncomp_bytes; }
+
+  /// Initialize the communication buffers. mesh_values tells whether
+  /// the values are those of a keyword attribute.
+  void init( void** ptrs, COM_Type type, int ncomp, 
+	     const int *sizes, const int *strds, bool mesh_values);
+
+  /// Round the local values of the shared nodes of the ith local pane
+  /// that are sent in a reduced-precision wire format as the receivers
+  /// see them, so that all copies are reduced from the same values.
+  void round_shared_values( int i);
+
+  /// Collect the shared nodes of the ith local pane sent to other 
+  /// processes into its Shared_refs, which are reset if reset is true.
+  void init_shared_refs( int i, bool reset);
+
+  /// Pack the outgoing message of pcb of the ith local pane into buf.
+  void pack_message( char *buf, int i, Pane_comm_buffers &pcb);
+
+  /// Unpack an incoming message of pcb from buf into its inbuf, which
+  /// must have been resized to the native size of the message.
+  void unpack_message( const char *buf, Pane_comm_buffers &pcb);
+
+  /// Obtain the buffers of the ith pending receive request.
+  Pane_comm_buffers &recv_buffers( int index);
+
+  /// Match the buffers of communicating panes on the same process.
+  void init_peers();
+
+  /// Lay out the messages to processes on the same node in the shared
+  /// segment of this process and locate incoming ones in the segments
+  /// of the other processes.
+  void init_shared_segment();
+
+  /// Copy the incoming messages in _shm_recvs from the shared segments.
+  void read_shared_segments();
+
+  /// Waits for an incoming message and returns its position in _reqs_recv.
+  int wait_any_recv();
+
+  /// Build or reuse the distributed graph communicator for the pconn.
+  void init_neighbor_graph();
+
+  /// Pack the messages recorded in _nbr_sends and start the neighborhood
+  /// collective for them and for the receives recorded in _nbr_recvs.
+  void begin_neighbor_update( const Buff_type btype);
+
+  /// Waits for the neighborhood collective and unpacks the received data
+  /// into the inbuf of the corresponding Pane_comm_buffers.
+  void end_neighbor_update();
+
   /// The id of the pconn being used.
   int                           _my_pconn_id;
 
+  /// The rank of this process in the communicator.
+  int                           _rank;
+
   /// Reference to the application window
   COM::Window                  *_appl_window;
   /// MPI Communicator
@@ -230,6 +441,65 @@ protected:
   /// The indices in buffs for each pending nonblocking receive request.
   std::vector<std::pair<int,int> > _reqs_indices;
 
+  /// Interior and border items of the local panes, obtained on demand
+  /// from a cache shared by all communicators.
+  std::vector<const Pane_split*>   _splits;
+
+  /// A message exchanged through the neighborhood collective.
+  struct Nbr_message {
+    Nbr_message( int r, int s, int d, int i, int j, Pane_comm_buffers *b)
+      : rank(r), src(s), dst(d), pane(i), buf(j), pcb(b) {}
+
+    /// Messages are ordered identically on the sending and receiving side.
+    bool operator<( const Nbr_message &m) const {
+      return rank<m.rank || ( rank==m.rank && 
+	( src<m.src || ( src==m.src && dst<m.dst)));
+    }
+
+    int                 rank;   // rank of the communicating process
+    int                 src;    // internal ID of the sending pane
+    int                 dst;    // internal ID of the receiving pane
+    int                 pane;   // index of the local pane
+    int                 buf;    // index in the buffers of the local pane
+    Pane_comm_buffers  *pcb;
+  };
+
+  /// The backend for messages across processes.
+  int                              _comm_mode;
+  /// The backend for newly constructed communicators.
+  static int                       _default_comm_mode;
+  /// The format of values in messages between processes.
+  int                              _wire_type;
+  /// Whether the values are those of a keyword attribute, such as the
+  /// nodal coordinates, which are always sent in WIRE_NATIVE.
+  bool                             _mesh_values;
+  /// The pconn of the values kept for WIRE_DELTA_FLOAT.
+  int                              _delta_pconn_id;
+  /// The values of the shared nodes kept for WIRE_DELTA_FLOAT.
+  std::vector<Shared_refs>         _shared_refs;
+  /// Distributed graph communicator of the pconn (owned by a cache
+  /// shared by all communicators of the same window and pconn).
+  MPI_Comm                         _nbr_comm;
+  /// Ranks of the neighboring processes, in the order of _nbr_comm.
+  std::vector<int>                 _nbr_ranks;
+  /// Outgoing and incoming messages of the next neighborhood collective.
+  std::vector<Nbr_message>         _nbr_sends, _nbr_recvs;
+  /// Aggregated buffers of the neighborhood collective.
+  std::vector<char>                _nbr_sendbuf, _nbr_recvbuf;
+  /// Byte counts and displacements for each neighbor.
+  std::vector<int>                 _nbr_scounts, _nbr_sdispls;
+  std::vector<int>                 _nbr_rcounts, _nbr_rdispls;
+  /// The pending neighborhood collective.
+  MPI_Request                      _nbr_req;
+  bool                             _nbr_pending;
+
+  /// The shared-memory segments of the processes on the node (owned by
+  /// a cache shared by all communicators on the same MPI communicator).
+  struct Shared_segment;
+  Shared_segment                  *_shm;
+  /// Incoming messages to be read from the shared segments.
+  std::vector<Pane_comm_buffers*>  _shm_recvs;
+
 private:
   // Disable the following operators
   Pane_communicator( const Pane_communicator &);
@@ -75,6 +75,35 @@ public:
     return _pconn_offset;
   }
 
+  /// Number of integers in the fingerprint of a pane.
+  enum { FINGERPRINT_SIZE=5 };
+
+  /// Name of the panel attribute holding the fingerprints of the panes
+  /// for which pconn was computed. Rocout writes it along with pconn,
+  /// recomputing it for the mesh and pconn being written.
+  static const char *fingerprint_name() { return "pconn_fingerprint"; }
+
+  /// Compute the fingerprint of the topology of a pane and its pconn: 
+  /// the numbers of real nodes and elements, a hash of the connectivity
+  /// of the real elements, a hash of the real part of pconn, and the 
+  /// number of panes in the window. Coordinates and ghosts are ignored.
+  static void pconn_fingerprint( const COM::Pane *pane, 
+				 const COM::Attribute *pconn, int *fp);
+
+  /// Recompute the fingerprints of the local panes of the window of pconn
+  /// that have them. Rocout calls it before writing them.
+  static void refresh_fingerprints( const COM::Attribute *pconn);
+
+  /// Determine whether the fingerprints stored with pconn (e.g., by a 
+  /// restart file) match the mesh of every pane in the window, so that
+  /// pconn need not be recomputed. Must be called collectively.
+  bool is_pconn_current( const COM::Attribute *pconn);
+
+  /// Store the fingerprints of the local panes for the given pconn,
+  /// creating the attribute if needed, so that they are written with
+  /// pconn. Must be called collectively.
+  void stamp_pconn( const COM::Attribute *pconn);
+
 protected:
 
   /** Create b2v mapping (pane connectivity) for nodes or edges and store
@@ -73,6 +73,20 @@ using std::setfill;
 class Pane_ghost_connectivity {
   
 public:
+  /// A node in the total-ordering format (P,N) together with its local
+  /// node id. Lists of nodes are kept in flat arrays sorted by (P,N).
+  struct PN_node {
+    PN_node() {}
+    PN_node( int p, int n, int i) : P(p), N(n), id(i) {}
+
+    bool operator<( const PN_node &n) const 
+    { return P<n.P || (P==n.P && N<n.N); }
+    bool operator==( const PN_node &n) const 
+    { return P==n.P && N==n.N; }
+
+    int P, N, id;
+  };
+
   /// Constructors
   explicit Pane_ghost_connectivity(COM::Window *window){
     _buf_window = window;
@@ -101,12 +115,12 @@ public:
    * [cell type][cell nodes in total-ordering format]
    *
    * Element ids are not needed, just use the same order in the RCS and GCR
-   * sections of the pconn.
+   * sections of the pconn. The panes are processed concurrently.
    */   
   void
   get_ents_to_send(vector<vector<vector<int> > > &gelem_lists,
-		   vector<vector<map<pair<int,int>,int> > > &nodes_to_send,
-		   vector<vector<deque<int> > > &elems_to_send,
+		   vector<vector<vector<PN_node> > > &nodes_to_send,
+		   vector<vector<vector<int> > > &elems_to_send,
 		   vector<vector<int> > &comm_sizes);
   
   // Determine # of ghost nodes to receive and map (P,N) to ghost node ids
@@ -115,7 +129,7 @@ public:
   process_received_data(
 			vector<vector<vector<int> > > &recv_info,
 			vector<vector<int> > &elem_renumbering,
-			vector<vector<map<pair<int,int>,int> > > &nodes_to_recv);
+			vector<vector<vector<PN_node> > > &nodes_to_recv);
   
   // Take the data we've collected and turn it into the pconn
   // Remember that there are 5 blocks in the pconn:
@@ -135,9 +149,9 @@ public:
   // for GCR
   
   void 
-  finalize_pconn(vector<vector<map<pair<int,int>,int> > > &nodes_to_send,
-		 vector<vector<map<pair<int,int>,int> > > &nodes_to_recv,
-		 vector<vector<deque<int> > > &elems_to_send,
+  finalize_pconn(vector<vector<vector<PN_node> > > &nodes_to_send,
+		 vector<vector<vector<PN_node> > > &nodes_to_recv,
+		 vector<vector<vector<int> > > &elems_to_send,
 		 vector<vector<int> > &elem_renumbering,
 		 vector<vector<vector<int> > > &recv_info);
 
@@ -155,6 +169,7 @@ public:
   // send_info = data to send
   // recv_info = buffer for receiving data
   // comm_sizes = amount of data to receive
+  // The data for all panes on a process are aggregated into one message.
   void 
   send_pane_info(vector<vector<vector<int> > > &send_info,
 		 vector<vector<vector<int> > > &recv_info,
@@ -164,6 +179,12 @@ private:
 
   void determine_shared_border();
 
+  // Per-pane steps of get_ents_to_send, process_received_data and
+  // finalize_pconn, run concurrently by for_each_pane.
+  static void ents_to_send_entry( void *args, int i);
+  static void received_data_entry( void *args, int i);
+  static void fill_pconn_entry( void *args, int i);
+
   void 
   mark_elems_from_nodes(std::vector<std::vector<bool> > &marked_nodes,
 			std::vector<std::vector<bool> > &marked_elems);
@@ -188,8 +209,8 @@ private:
   vector<vector<int> > _p_gorder;
   Attribute* _w_n_gorder;
 
-  // mapping from total ordering to local node id
-  vector<map<pair<int,int>,int> > _local_nodes;
+  // mapping from total ordering to local node id, sorted by (P,N)
+  vector<vector<PN_node> > _local_nodes;
 
   // pointers to all local panes
   vector<Pane*> _panes;
@@ -0,0 +1,102 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file Pane_reorder.h
+ * Utility for renumbering the nodes and elements of panes to improve
+ * the locality of element loops.
+ */
+
+#ifndef _PANE_REORDER_H_
+#define _PANE_REORDER_H_
+
+#include "roccom_devel.h"
+#include "mapbasic.h"
+#include <vector>
+
+MAP_BEGIN_NAMESPACE
+
+/** Renumbers the real nodes and real elements within each unstructured
+ *  pane of a window. Nodal and elemental attributes, the connectivity
+ *  tables, the ridges and the pane connectivity are permuted consistently.
+ *  Ghost nodes and elements keep their positions after the real ones,
+ *  and elements stay in their connectivity tables. Since pconn lists
+ *  only local ids, each pane is renumbered independently.
+ *
+ *  The original ids are recorded in the attributes node_order and
+ *  elem_order of the window, which are permuted along with the others,
+ *  so repeated reorderings compose and restore returns to the ordering
+ *  before the first one. Attributes inherited with INHERIT_USE share
+ *  their arrays with the parent window, which is therefore permuted too.
+ */
+class Pane_reorder {
+public:
+  enum Method {
+    RCM,     // Reverse Cuthill-McKee on the node graph; elements are
+             // sorted by their first node in the new order.
+    HILBERT  // Elements along a Hilbert curve through their centroids;
+             // nodes in the order they are first referenced.
+  };
+
+  /// Name of the attribute recording the original ids of the nodes.
+  static const char *node_order_name() { return "node_order"; }
+  /// Name of the attribute recording the original ids of the elements.
+  static const char *elem_order_name() { return "elem_order"; }
+
+  /// Renumber the unstructured panes of a window with the given method.
+  static void reorder( COM::Window *win, int method);
+
+  /// Restore the original ordering recorded by reorder.
+  static void restore( COM::Window *win);
+
+  /** Compute new orders of the real nodes and elements of a pane. At
+   *  return, nodes[k] is the (0-based) old index of the kth real node,
+   *  and elems[k] is the old index of the kth element, where elements
+   *  are indexed as in elemental attributes. Ghost elements are mapped
+   *  to themselves. */
+  static void compute_order( const COM::Pane *pane, int method,
+			     std::vector<int> &nodes, std::vector<int> &elems);
+
+  /// Apply the permutations computed by compute_order to a pane.
+  static void permute( COM::Pane *pane, const std::vector<int> &nodes,
+		       const std::vector<int> &elems);
+
+protected:
+  /// Compute a reverse Cuthill-McKee ordering of the real nodes.
+  static void rcm_nodes( const COM::Pane *pane, std::vector<int> &nodes);
+
+  /// Order the real elements along a Hilbert curve through their centroids.
+  static void hilbert_elements( const COM::Pane *pane,
+				std::vector<int> &elems);
+
+  /// Permute the real items of every component of an attribute.
+  static void permute_attribute( COM::Attribute *a, int first,
+				 const std::vector<int> &perm);
+
+  /// Create an attribute recording the original ids if it does not exist.
+  static void init_order_attribute( COM::Window *win, const char *name,
+				    char loc);
+};
+
+MAP_END_NAMESPACE
+
+#endif
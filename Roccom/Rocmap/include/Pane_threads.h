@@ -0,0 +1,56 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file Pane_threads.h
+ * Thread-parallel loops over the local panes of a process.
+ */
+
+#ifndef __PANE_THREADS_H
+#define __PANE_THREADS_H
+
+#include "mapbasic.h"
+
+MAP_BEGIN_NAMESPACE
+
+/** Call func(arg, i) for i=0,...,n-1. If Rocmap is built with pthreads,
+ *  the calls are distributed dynamically over the calling thread and the
+ *  threads of a pool that persists across calls (see set_pane_threads);
+ *  otherwise, or when a loop is already running, they are made in order
+ *  by the calling thread. The calls must not modify shared state such as
+ *  Roccom windows. */
+void for_each_pane( int n, void (*func)( void *arg, int i), void *arg);
+
+/** Set the number of threads of for_each_pane, including the calling 
+ *  thread, or restore the default if n<=0. The default is taken from 
+ *  the environment variable ROCMAP_THREADS if it is set. Otherwise, it
+ *  is the number of processors if this is the only process on the node 
+ *  and 1 if there are more, as reported by the MPI launcher (or as for 
+ *  a single node if it does not tell). */
+void set_pane_threads( int n);
+
+/// Obtain the number of threads of for_each_pane.
+int pane_threads();
+
+MAP_END_NAMESPACE
+
+#endif
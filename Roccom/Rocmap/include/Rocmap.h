@@ -42,16 +42,56 @@ public:
 
   /// Loads Rocmap onto Roccom with a given module name.
   static void load( const std::string &mname);
-  /// Unloads Rocmap from Roccom.
+  /// Unloads Rocmap from Roccom. When the last instance is unloaded, it
+  /// releases the caches of Rocmap and unregisters its hooks from Roccom
+  /// and Rocout. It must be called collectively.
   static void unload( const std::string &mname);
 
+  /** Set an option of Rocmap. The option "comm" selects the backend of 
+   *  subsequent shared-node and ghost updates across processes: "p2p" 
+   *  (default), "neighbor" (MPI-3 neighborhood collectives over the pconn
+   *  graph), or "shm" (MPI-3 shared memory between processes on the same
+   *  node). The option "wire" selects the format of double-precision 
+   *  values of user-defined attributes sent between processes by the 
+   *  reductions and ghost updates of Rocmap: "native" (default) or 
+   *  "float" (rounded to single precision). The mesh is always sent as 
+   *  it is. "delta" is accepted as "float", since each call starts from 
+   *  scratch; use Pane_communicator::set_wire_type for repeated updates.
+   *  The option "threads" sets the number of threads working on the 
+   *  panes of a process, or restores the default with "0" (see 
+   *  set_pane_threads). */
+  static void set_option( const char *opt, const char *val);
+
   /** Compute pane connectivity map between shared nodes.
    *  If pconn was not yet initialized, this routine will allocate memory
    *  for it. Otherwise, this routine will copy up to 
-   *  the capacity of the array */
+   *  the capacity of the array. If pconn is the pconn of its window, it
+   *  is stamped as by stamp_pconn after being computed, and it is not 
+   *  recomputed if the stamp (e.g., read from a restart file) matches. */
   static void compute_pconn( const COM::Attribute *mesh, 
 			     COM::Attribute *pconn);
+
+  /** Store with pconn the fingerprints of the topology of the panes, in
+   *  the panel attribute "pconn_fingerprint", creating it if needed. 
+   *  Rocout writes them with pmesh, and compute_pconn then reuses pconn
+   *  read back along with them as long as the topology is unchanged.
+   *  Must be called collectively. */
+  static void stamp_pconn( const COM::Attribute *mesh, 
+			   COM::Attribute *pconn);
   
+  /** Renumber the nodes and elements within each unstructured pane of 
+   *  the window of mesh to improve locality, using "rcm" (reverse 
+   *  Cuthill-McKee, default) or "hilbert" (Hilbert curve over element 
+   *  centroids). All nodal and elemental attributes and pconn are permuted
+   *  consistently, and the original ids are recorded in the attributes 
+   *  node_order and elem_order. Must be called collectively. */
+  static void reorder_mesh( COM::Attribute *mesh, const char *method=NULL);
+
+  /** Restore the original ordering of the nodes and elements recorded by
+   *  reorder_mesh, for example before writing output. Must be called 
+   *  collectively. */
+  static void restore_order( COM::Attribute *mesh);
+
   /** Determine the nodes at pane boundaries of a given mesh. 
    *  The argument isborder must be a nodal attribute of integer type. 
    *  At return, isborder is set to 1 for border nodes, and 0 for others */
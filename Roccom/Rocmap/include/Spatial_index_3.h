@@ -0,0 +1,193 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file Spatial_index_3.h
+ * A kd-tree for box queries over points in 3-D, stored implicitly in
+ * flat arrays.
+ */
+
+#ifndef _SPATIAL_INDEX_3_H_
+#define _SPATIAL_INDEX_3_H_
+
+#include <vector>
+#include <algorithm>
+
+#include "mapbasic.h"
+
+MAP_BEGIN_NAMESPACE
+
+/** A balanced kd-tree over a set of points in 3-D. The tree is implicit:
+ *  the root of the subtree of a range [lo,hi) of the arrays is at the
+ *  middle of the range, its left subtree in the lower half and its right
+ *  subtree in the upper half. The coordinates are stored contiguously in
+ *  tree order, so a query touches no pointers and builds need no
+ *  per-node allocation. Building is O(n log n). The Point type must
+ *  provide operator[] for its coordinates.
+ */
+template <class Point>
+class Spatial_index_3 {
+public:
+  Spatial_index_3() {}
+
+  /// Build the index from the points in [first,last).
+  template <class Iterator>
+  void build( Iterator first, Iterator last) {
+    _pnts.assign( first, last);
+    const int n = _pnts.size();
+
+    std::vector<double> xyz( 3*n);
+    for ( int i=0; i<n; ++i)
+      for ( int k=0; k<3; ++k) xyz[3*i+k] = _pnts[i][k];
+
+    _ids.resize( n);
+    for ( int i=0; i<n; ++i) _ids[i] = i;
+    _dims.resize( n);
+    if ( n) build_subtree( xyz, 0, n);
+
+    // Store the points and their coordinates in tree order.
+    std::vector<Point> pnts; pnts.reserve( n);
+    _xyz.resize( 3*n);
+    for ( int i=0; i<n; ++i) {
+      pnts.push_back( _pnts[_ids[i]]);
+      for ( int k=0; k<3; ++k) _xyz[3*i+k] = xyz[3*_ids[i]+k];
+    }
+    _pnts.swap( pnts);
+  }
+
+  /// Build the index from the points in a vector.
+  void build( const std::vector<Point> &pnts)
+  { build( pnts.begin(), pnts.end()); }
+
+  /// Number of points in the index.
+  int size() const { return _pnts.size(); }
+
+  /// Copy the points in the closed box [lb,ub] into out.
+  template <class OutputIterator>
+  OutputIterator search( OutputIterator out,
+			 const Point &lb, const Point &ub) const {
+    const double l[3] = { lb[0], lb[1], lb[2] };
+    const double u[3] = { ub[0], ub[1], ub[2] };
+    _found.clear();
+    search( l, u, _found);
+    for ( int i=0, n=_found.size(); i<n; ++i) *out++ = _pnts[ _found[i]];
+    return out;
+  }
+
+  /// Obtain the positions (in the input of build) of the points within
+  /// distance tol of q in each coordinate direction.
+  void search( const double q[3], double tol, std::vector<int> &ids) const {
+    const double l[3] = { q[0]-tol, q[1]-tol, q[2]-tol };
+    const double u[3] = { q[0]+tol, q[1]+tol, q[2]+tol };
+    int first = ids.size();
+    search( l, u, ids);
+    for ( int i=first, n=ids.size(); i<n; ++i) ids[i] = _ids[ ids[i]];
+  }
+
+  /** Batch query for the points in [first,last) with a common tolerance.
+   *  On output, the matches of the ith query are in
+   *  ids[offsets[i]] to ids[offsets[i+1]-1].
+   */
+  template <class Iterator>
+  void search( Iterator first, Iterator last, double tol,
+	       std::vector<int> &offsets, std::vector<int> &ids) const {
+    offsets.clear(); offsets.push_back( 0);
+    ids.clear();
+    for ( ; first!=last; ++first) {
+      const double q[3] = { (*first)[0], (*first)[1], (*first)[2] };
+      search( q, tol, ids);
+      offsets.push_back( ids.size());
+    }
+  }
+
+private:
+  // Partition _ids[lo,hi) so that the median along the dimension of
+  // the largest extent is in the middle.
+  void build_subtree( const std::vector<double> &xyz, int lo, int hi) {
+    for (;;) {
+      const int mid = (lo+hi)/2;
+      if ( hi-lo == 1) { _dims[mid] = 0; return; }
+
+      double bmin[3] = { xyz[3*_ids[lo]], xyz[3*_ids[lo]+1], xyz[3*_ids[lo]+2]};
+      double bmax[3] = { bmin[0], bmin[1], bmin[2] };
+      for ( int i=lo+1; i<hi; ++i) {
+	for ( int k=0; k<3; ++k) {
+	  const double x = xyz[3*_ids[i]+k];
+	  if ( x<bmin[k]) bmin[k] = x; else if ( x>bmax[k]) bmax[k] = x;
+	}
+      }
+      int d = 0;
+      for ( int k=1; k<3; ++k)
+	if ( bmax[k]-bmin[k] > bmax[d]-bmin[d]) d = k;
+
+      std::nth_element( _ids.begin()+lo, _ids.begin()+mid, _ids.begin()+hi,
+			Coordinate_less( xyz, d));
+      _dims[mid] = d;
+
+      if ( mid-lo > 0) build_subtree( xyz, lo, mid);
+      if ( hi-mid-1 <= 0) return;
+      lo = mid+1;
+    }
+  }
+
+  // Append the tree positions of the points in [l,u] to found.
+  void search( const double l[3], const double u[3],
+	       std::vector<int> &found) const {
+    if ( _pnts.empty()) return;
+
+    int stack[2*64], top=0;
+    stack[top++] = 0; stack[top++] = _pnts.size();
+    while ( top) {
+      const int hi = stack[--top], lo = stack[--top];
+      const int mid = (lo+hi)/2;
+      const double *p = &_xyz[3*mid];
+
+      if ( p[0]>=l[0] && p[0]<=u[0] && p[1]>=l[1] && p[1]<=u[1] &&
+	   p[2]>=l[2] && p[2]<=u[2])
+	found.push_back( mid);
+
+      const int d = _dims[mid];
+      if ( mid>lo && l[d]<=p[d])
+      { stack[top++] = lo; stack[top++] = mid; }
+      if ( hi>mid+1 && u[d]>=p[d])
+      { stack[top++] = mid+1; stack[top++] = hi; }
+    }
+  }
+
+  struct Coordinate_less {
+    Coordinate_less( const std::vector<double> &x, int d) : xyz(x), dim(d) {}
+    bool operator()( int a, int b) const
+    { return xyz[3*a+dim] < xyz[3*b+dim]; }
+    const std::vector<double> &xyz;
+    int dim;
+  };
+
+  std::vector<Point>   _pnts;  // points in tree order
+  std::vector<double>  _xyz;   // their coordinates
+  std::vector<int>     _ids;   // their positions in the input
+  std::vector<char>    _dims;  // splitting dimensions
+  mutable std::vector<int> _found; // scratch space for queries
+};
+
+MAP_END_NAMESPACE
+
+#endif
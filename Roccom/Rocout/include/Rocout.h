@@ -34,9 +34,18 @@
 #define _ROCOUT_H_
 
 #include <map>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
 #include "roccom.h"
 #include "HDF4.h"
 #include "roccom_devel.h"
+#include "Rocout_native.h"
+#include "Rocout_drain.h"
+#ifdef USE_PTHREADS
+#include "Rocout_writers.h"
+#endif // USE_PTHREADS
 
 #ifdef USE_CGNS
 #include "Rocout_cgns.h"
@@ -45,6 +54,9 @@
 #define MODE_MODIFY CG_MODE_MODIFY
 #endif // USE_CGNS
 
+class CGNS_batch;
+class Pane_aggregator;
+
 /**
  ** Write the data for the given attribute to file.
  **
@@ -60,12 +72,14 @@
  ** \param ghosthandle "ignore" or "write" on ghost data.
  ** \param errorhandle "ignore", "warn", or "abort" on errors.
  ** \param mode Write == 0, append == 1. (Input)
+ ** \param batch If not NULL, the batch holding the file open. (Input/Output)
  **/
 void write_attr_CGNS(const std::string& fname, const std::string& mfile, 
                      const COM::Attribute* attr, const char* material, 
                      const char* timelevel, int pane_id,
                      const std::string& ghosthandle,
-                     const std::string& errorhandle, int mode);
+                     const std::string& errorhandle, int mode,
+                     CGNS_batch* batch);
 
 /** \name Module loading and unloading
  * \{
@@ -78,8 +92,13 @@ extern "C" void Rocout_unload_module( const char *name);
 //\}
 
 
+struct WriteAttrInfo;
+
 class Rocout : public COM_Object {
  public:
+  /// The values of the options, by their names.
+  typedef std::map<std::string, std::string> Options;
+
   /** \name User interface
    *  \{
    */
@@ -140,11 +159,37 @@ class Rocout : public COM_Object {
                       const MPI_Comm* comm=NULL,
                       const int* pane_id=NULL);
 
-  /** Wait for the completion of an asychronous write operation.
+  /** Wait for the completion of the asychronous write operations, e.g.
+   *  of the previous restart dump before starting the next. If the option
+   *  "compress" or "incremental" is on, process 0 then reports the ratio
+   *  of the array data to the bytes stored and the throughput of the
+   *  writes since the last call. The files written since the last call
+   *  are then indexed if the option "index" is on.
    */
   void sync();
 
-  /** Generate a control file for Rocin.
+  /** Copy the files written since the last call from "localdir" to the
+   *  directory given by the option "drain", in the background, once the
+   *  asynchronous writes queued before the call have finished. The call
+   *  itself does not wait for them, unless the option "index" is on, in
+   *  which case it indexes their files first. The files keep their paths
+   *  relative to "localdir".
+   *
+   * \param mark The number of the files copied, to be compared with the
+   *        number given by drained; -1 if the option "drain" is not set.
+   */
+  void drain_mark( int* mark);
+
+  /** Obtain the number of the last call of drain_mark whose files have
+   *  all been copied, or 0.
+   *
+   * \param mark The number. (Output)
+   * \param wait If present and nonzero, wait for all the copies first.
+   */
+  void drained( int* mark, const int* wait=NULL);
+
+  /** Generate a control file for Rocin. Unless the option "async" is
+   *  on, the files written so far are indexed first if "index" is on.
    *
    * \param window_name The name of the Roccom window.
    * \param file_prfixes The prefixes of the data files.
@@ -157,7 +202,50 @@ class Rocout : public COM_Object {
   /** Set an option for Rocout, such as controlling the output format.
    *
    * \param option_name the option name: "format", "async", "mode",
-   *        "localdir", "rankwidth", "pnidwidth", "separator" or "errorhandle".
+   *        "localdir", "rankwidth", "pnidwidth", "separator", "errorhandle",
+   *        "rankdir", "ghosthandle", "aggregate", "writethreads",
+   *        "writebuffers", "compress", "incremental", "verify", "index",
+   *        "partial", "drain", "drainrate" or "drainkeep".
+   *        The option "aggregate" gives the number k of
+   *        consecutive processes whose panes are written by the first of
+   *        them, or "node" for one writer per shared-memory node; it
+   *        defaults to 1, i.e., every process writes its own files. With
+   *        "async" on, "writethreads" threads (default 1) write the data
+   *        copied into "writebuffers" reusable buffers (default 2); a
+   *        write waits for a free buffer. The option "format" is "HDF4"
+   *        (or "HDF"), "CGNS", "HDF5", or "NATIVE" for the raw binary
+   *        files described in rocin_native.h, which Rocin can map into
+   *        memory. For "NATIVE", the option "compress" may be "zlib" or
+   *        "shuffle-zlib" to compress the larger arrays, the latter after
+   *        grouping the bytes of the values by significance, or "off"
+   *        (the default). For "NATIVE", "incremental" may be set to a
+   *        number k > 0 to write an array that has not changed since the
+   *        last dump, e.g. the connectivity, as a reference to the earlier
+   *        file, which Rocin follows. An array is referenced by at most k
+   *        dumps in a row, so only the last k+1 dumps must be kept.
+   *        It is matched by its size and 128-bit hash; with "verify" on,
+   *        the earlier data is also read back and compared (default off).
+   *        For "HDF4" and "CGNS", "index" on writes next to each file the
+   *        index of its blocks (see Rocin::write_index), which spares
+   *        Rocin the scan of the file. Since the attributes of a dump are
+   *        appended to the file one at a time, it is indexed once the dump
+   *        is complete: by sync, by write_rocin_control_file with "async"
+   *        off, when drain_mark copies it, and by finalize.
+   *        For "CGNS", "partial" on makes the processes of each group
+   *        given by "aggregate" write their own panes, in turn, into the
+   *        files of the first of them, instead of sending the panes to
+   *        it; the zones of the whole group are created first.
+   *        If "drain" is set to a directory, e.g. on the shared file
+   *        system while "localdir" is on node-local storage, drain_mark
+   *        copies the files written since its last call to it in the
+   *        background, at no more than "drainrate" MB/s if it is positive
+   *        (the default is 0, for no limit). If "drainkeep" is set to a
+   *        number k > 0, the local files are removed once they have been
+   *        copied and k later calls of drain_mark have all their files
+   *        copied, unless they were written again; by default they are
+   *        kept. A file written after its removal is written anew, so k
+   *        must cover the dumps that append to the files of an earlier
+   *        one, or that refer to them with "incremental".
    * \param option_val the option value.
    */
   void set_option( const char* option_name,
@@ -221,22 +309,141 @@ protected:
   static
   void* write_attr_internal(void* attrInfo);
 
+  /** Write now, or in the background if the option "async" is on.
+   *
+   * \param ai Information on what to write and where to write it.
+   */
+  void write(WriteAttrInfo* ai);
+
+  /// Obtain the local panes to be written.
+  static
+  void local_panes(const WriteAttrInfo* ai, std::vector<int>& paneIds);
+
+  /// Whether the mesh is written along with the attribute.
+  static
+  bool with_mesh(const WriteAttrInfo* ai);
+
+  /** Write the attribute of a pane into the file of a process.
+   *
+   * \param ai Information on what to write and where to write it.
+   * \param attr The attribute, in the window holding the pane.
+   * \param rank The rank of the process whose file is written.
+   * \param paneId The pane to be written.
+   * \param append Whether to append to the files written before.
+   * \param written The files written so far by this call, which are
+   *        appended to.
+   * \param batch For CGNS, the batch holding the file open, if any.
+   */
+  static
+  void write_pane(WriteAttrInfo* ai, const COM::Attribute* attr, int rank,
+                  int paneId, int append, std::set<std::string>& written,
+                  CGNS_batch* batch = NULL);
+
+  /// Panes to be written, each with the attribute of its window.
+  typedef std::vector<std::pair<const COM::Attribute*, int> > Pane_list;
+
+  /** Write panes into CGNS files, opening each file once and creating
+   *  its zones in one pass.
+   *
+   * \param ai Information on what to write and where to write it.
+   * \param items The panes to be written.
+   * \param rank The rank of the process whose files are written.
+   * \param append Whether to append to the files written before.
+   * \param written The files written by this call, to be indexed.
+   * \param agg If not NULL, the processes of the group of agg take turns
+   *        writing their panes into the files of its writer. This is a
+   *        collective call over the group.
+   */
+  static
+  void write_panes_CGNS(WriteAttrInfo* ai, const Pane_list& items, int rank,
+                        int append, std::set<std::string>& written,
+                        Pane_aggregator* agg);
+
+  /** Remember the files written, for the next call of drain_mark.
+   *
+   * \param options The options of the write.
+   * \param seq The number of the write in the pool of writer threads.
+   * \param prefix The prefix of the files, which names them in the pool.
+   */
+  void add_undrained(const Options& options,
+                     const std::set<std::string>& files, long long seq,
+                     const std::string& prefix);
+
+  /** Remember the files written, to be indexed by write_indexes.
+   *
+   * \param prefix The prefix of the files, which names them in the pool.
+   */
+  void add_unindexed(const std::set<std::string>& files,
+                     const std::string& prefix);
+
+  /// Write the indexes of the files written since they were indexed.
+  void write_indexes();
+
+  /// Take the files written up to the write upto, for the drainer.
+  static void collect_undrained(void* rout, long long upto,
+                                File_drainer::Copies& copies);
+
+  /// Remove the old local files that were not written again, and let
+  /// the files copied be written again, for the drainer.
+  static void finish_drained(void* rout, const std::vector<std::string>& old);
+
+  /// The path in the "drain" directory of a file written in "localdir".
+  std::string drain_path(const Options& options, const std::string& file);
+
+  /// The format of the files of the given prefix, by its extension.
+  std::string format_of(const std::string& prefix);
+
+  /// Whether writes in the given format communicate and so cannot be
+  /// done in the background.
+  bool is_collective(const std::string& format);
+
   /** Builds a filename from the given prefix and rank.
    *
+   * \param options The options of the write.
    * \param pre Filename prefix.
+   * \param format The format of the file, which gives its extension.
    * \param rank The rank of this MPI process.
    * \param pPaneId A pointer to the pane id.
    * \param check Check for an existing file.
    */
-  std::string get_fname(const std::string& pre, int rank = -1,
-                        const int paneId = 0, bool check = false);
+  std::string get_fname(const Options& options,
+                        const std::string& pre, const std::string& format,
+                        int rank = -1, const int paneId = 0,
+                        bool check = false);
   //\}
 
-  std::map<std::string, std::string> _options;
+  /// Print the compression statistics since the last call and reset them.
+  void report_compression();
+
+  Options _options;
+  /// Writer of each process in the last aggregated write, on process 0.
+  std::vector<int> _aggregators;
+  /// Compression statistics of the native writes since the last sync.
+  Native_stats _stats;
+  /// Where the arrays of the previous native dumps are stored.
+  Native_history _history;
+  /// A file written since it was last taken by drain_mark.
+  struct Undrained {
+    long long seq;        ///< The number of its last write.
+    std::string dst;      ///< Its path in the "drain" directory.
+  };
+  /// Files written since they were last taken by drain_mark.
+  std::map<std::string, Undrained> _undrained;
+  /// The prefix of each file drained, which names it in the pool.
+  std::map<std::string, std::string> _drain_prefixes;
+  /// The prefixes held by the drainer while it copies their files.
+  std::vector<std::string> _drain_held;
+  /// Files written since they were last indexed, with their prefixes.
+  std::map<std::string, std::string> _unindexed;
 # ifdef USE_PTHREADS
-  std::vector<pthread_t> _writers;
-  static Semaphore _writesem;
+  Writer_pool _pool;
+  Mutex _stats_lock;
+  Mutex _drain_lock;
+  Mutex _index_lock;
 # endif // USE_PTHREADS
+  /// Copies the files to the "drain" directory. It uses the members above,
+  /// so it is destroyed first.
+  File_drainer _drainer;
 };
 
 #endif
@@ -0,0 +1,158 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file Rocout_aggregate.h
+ *  Declaration of the staging of panes and of their gathering onto
+ *  aggregator processes.
+ */
+#ifndef _ROCOUT_AGGREGATE_H
+#define _ROCOUT_AGGREGATE_H
+
+#include "roccom.h"
+#include "roccom_devel.h"
+#include <string>
+#include <vector>
+
+/**
+ ** Copies the panes of a window into a buffer, so that they can be
+ ** written while the application goes on changing its arrays.
+ **
+ ** Only the arrays that the attribute being written needs are copied, and
+ ** they are packed into one buffer along with the sizes of the panes. The
+ ** copies are described by a private window whose arrays point into the
+ ** buffer, so the writers of all formats handle them like the original
+ ** panes. The buffer is kept when the window is released, so a stage used
+ ** for dump after dump allocates its memory only once.
+ **/
+class Pane_stage {
+public:
+  Pane_stage() : _win(NULL) {}
+  virtual ~Pane_stage();
+
+  /** Copy the given local panes for writing an attribute.
+   *
+   * \param attr The attribute to be written.
+   * \param with_mesh Whether the mesh is written along with attr, as
+   *        decided by the writers of the individual formats.
+   * \param pane_ids The local panes to be copied.
+   * \return The attribute in the window of the copies.
+   */
+  const COM::Attribute* stage(const COM::Attribute* attr, bool with_mesh,
+                              const std::vector<int>& pane_ids);
+
+  /// Delete the window of the copies but keep the memory of the buffer.
+  void release();
+
+protected:
+  /// Select the attributes whose arrays are copied for attr.
+  static void select(const COM::Attribute* attr, bool with_mesh,
+                     std::vector<const COM::Attribute*>& attrs);
+
+  /// Append the local panes to a buffer.
+  static void pack(const COM::Window* win,
+                   const std::vector<const COM::Attribute*>& attrs,
+                   bool with_conn, const std::vector<int>& pane_ids,
+                   std::vector<char>& buf);
+
+  /// Create the window _win with the attributes of win, and copy the
+  /// window attributes of win.
+  void new_window(const COM::Window* win);
+
+  /// Register the panes packed in a buffer with the window _win.
+  void unpack(const std::vector<const COM::Attribute*>& attrs, char* buf);
+
+  std::vector<char> _buf;    ///< Packed panes.
+  std::vector<char> _wbuf;   ///< Copies of the window attributes.
+  COM::Window* _win;         ///< Window of the packed panes.
+
+private:
+  Pane_stage(const Pane_stage&);
+  Pane_stage& operator=(const Pane_stage&);
+};
+
+/**
+ ** Gathers the panes of groups of processes onto one process per group,
+ ** the writer, which then writes the files on behalf of its group.
+ **
+ ** The processes of a communicator are split into groups of k consecutive
+ ** ranks, or into one group per shared-memory node if the group is given
+ ** as "node". The writer is the lowest rank of each group. Every other
+ ** process packs its panes as a Pane_stage does and sends them in one
+ ** message. The writer keeps the received panes in a private window whose
+ ** arrays point into the received messages.
+ **/
+class Pane_aggregator : public Pane_stage {
+public:
+  /** Split a communicator into groups. This is a collective call.
+   *
+   * \param comm The communicator of the processes writing the window.
+   * \param group The group size k as a string, or "node".
+   */
+  Pane_aggregator(MPI_Comm comm, const std::string& group);
+  ~Pane_aggregator();
+
+  /** Return the aggregator of a communicator for the given group size,
+   *  so that the groups are split only once. The aggregator is created
+   *  by the first call, which is collective, and deleted when comm is
+   *  freed or at MPI_Finalize.
+   */
+  static Pane_aggregator* get(MPI_Comm comm, const std::string& group);
+
+  /// Rank in the communicator of the writer of this process's group.
+  int writer() const { return _writer; }
+
+  /// On process 0 of the communicator, the writer of each process.
+  const std::vector<int>& writers() const { return _writers; }
+
+  /// The communicator of the group of this process.
+  MPI_Comm group() const { return _group; }
+
+  /// Whether this process writes on behalf of its group.
+  bool is_writer() const { return _writer == _rank; }
+
+  /** Send the given local panes to the writer of the group. This is a
+   *  collective call over the group.
+   *
+   * \param attr The attribute to be written.
+   * \param with_mesh Whether the mesh is written along with attr.
+   * \param pane_ids The local panes to be sent.
+   * \return On the writer, the window of the panes received from the
+   *         other processes of the group; NULL on the other processes.
+   *         The window is owned by the aggregator.
+   */
+  const COM::Window* gather(const COM::Attribute* attr, bool with_mesh,
+                            const std::vector<int>& pane_ids);
+
+  /// Return true if the group size is a valid value of the option.
+  static bool is_group(const std::string& group);
+
+  /// Return true if the option asks for groups of more than one process.
+  static bool is_enabled(const std::string& group);
+
+protected:
+  MPI_Comm _group;
+  int _rank, _writer;
+  std::vector<int> _writers;
+};
+
+#endif // !defined(_ROCOUT_AGGREGATE_H)
@@ -30,7 +30,97 @@
 #define _ROCOUT_CGNS_H
 
 #include "roccom.h"
+#include <map>
 #include <string>
+#include <vector>
+
+/**
+ ** The dimensions and size of the Zone_t node of a pane.
+ **
+ ** It holds only ints, so that the zones of several processes can be
+ ** gathered as MPI_INTs.
+ **/
+struct CGNS_zone {
+  int pane_id;     ///< The pane id, which names the zone.
+  int cell_dim;    ///< The cell dimension of the Base_t node.
+  int phys_dim;    ///< The physical dimension of the Base_t node.
+  int structured;  ///< 1 for a structured zone, 0 for an unstructured one.
+  int sizes[9];    ///< The size of the zone, as given to cg_zone_write.
+};
+
+/**
+ ** Keep a CGNS file open across the panes written into it.
+ **
+ ** Without a batch, write_attr_CGNS opens and closes the file for every
+ ** pane and searches all Zone_t nodes of the base for the zone of the pane.
+ ** With a batch, the file stays open until another file is opened or the
+ ** batch is closed, and the zones created by presize_zones_CGNS are looked
+ ** up in a table.
+ **/
+class CGNS_batch {
+public:
+  explicit CGNS_batch(const std::string& errorhandle)
+    : _fn(-1), _errorhandle(errorhandle) {}
+  ~CGNS_batch() { close(); }
+
+  /** Return the CGNS file number of a file, opening it if it is not the
+   *  open one. The open file is closed first.
+   *
+   * \param fname The name of the file.
+   * \param mode Write == 0, append == 1. With 0, the file is created or
+   *        truncated when it is opened.
+   */
+  int open(const std::string& fname, int mode);
+
+  /// Close the open file, if any.
+  void close();
+
+  /// Return the index of a zone of a base of the open file, or 0.
+  int zone(int B, const std::string& name) const;
+
+  /// Record the index of a zone of a base of the open file.
+  void set_zone(int B, const std::string& name, int Z)
+  { _zones[B][name] = Z; }
+
+private:
+  std::string _fname;          ///< The name of the open file.
+  int _fn;                     ///< Its CGNS file number, or -1.
+  std::string _errorhandle;    ///< "ignore", "warn", or "abort" on errors.
+  /// The index of each zone by name, for each base of the open file.
+  std::map<int, std::map<std::string, int> > _zones;
+
+  CGNS_batch(const CGNS_batch&);
+  CGNS_batch& operator=(const CGNS_batch&);
+};
+
+/**
+ ** Compute the Zone_t node of a pane as write_attr_CGNS writes it.
+ **
+ ** \param pane The pane. (Input)
+ ** \param zone The dimensions and size of its zone. (Output)
+ **/
+void zone_of_pane_CGNS(const COM::Pane& pane, CGNS_zone& zone);
+
+/**
+ ** Create the Zone_t nodes of the given panes in one pass over the file.
+ **
+ ** Open the file in the batch, find or create the base of the material,
+ ** read the existing zones once and create the missing ones. The indices
+ ** of the zones are recorded in the batch, so write_attr_CGNS need not
+ ** search for them. Zones of the wrong size are left to write_attr_CGNS,
+ ** which reports them.
+ **
+ ** \param batch The batch holding the file open. (Input/Output)
+ ** \param fname The name of the file. (Input)
+ ** \param zones The zones of the panes to be written. (Input)
+ ** \param material The name of the material. (Input)
+ ** \param errorhandle "ignore", "warn", or "abort" on errors.
+ ** \param mode Write == 0, append == 1. (Input)
+ **/
+void presize_zones_CGNS(CGNS_batch& batch, const std::string& fname,
+                        const std::vector<CGNS_zone>& zones,
+                        const char* material,
+                        const std::string& errorhandle, int mode);
 
 /**
  ** Write the data for the given attribute to file.
@@ -47,12 +137,14 @@
  ** \param ghosthandle "ignore" or "write" on ghost data.
  ** \param errorhandle "ignore", "warn", or "abort" on errors.
  ** \param mode Write == 0, append == 1. (Input)
+ ** \param batch If not NULL, the batch holding the file open. (Input/Output)
  **/
 void write_attr_CGNS(const std::string& fname, const std::string& mfile, 
                      const COM::Attribute* attr, const char* material, 
                      const char* timelevel, int pane_id,
                      const std::string& ghosthandle,
-                     const std::string& errorhandle, int mode);
+                     const std::string& errorhandle, int mode,
+                     CGNS_batch* batch = NULL);
 
 #endif // !defined(_ROCOUT_CGNS_H)
 
@@ -0,0 +1,145 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+/** \file Rocout_drain.h
+ *  Declaration of the copying of files from node-local storage to the
+ *  shared file system in the background.
+ */
+#ifndef _ROCOUT_DRAIN_H
+#define _ROCOUT_DRAIN_H
+
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+#ifdef USE_PTHREADS
+#include <pthread.h>
+#include "Sync.h"
+#endif // USE_PTHREADS
+
+/**
+ ** Copies the files written to node-local storage to the shared file
+ ** system, one at a time, on a thread of its own.
+ **
+ ** Each mark queued collects the files to be copied from its source, once
+ ** the writes before the mark have finished, and is reached when they
+ ** have all been copied, e.g. when a dump may be used for a restart. The
+ ** copies are synced to disk before they replace the earlier ones, and
+ ** the index of a file (see Rocin::write_index) is copied along with it.
+ ** A copy that fails is tried again by the next mark, and no mark is
+ ** reached until it succeeds. The local files are kept, unless told to
+ ** keep only those of the last few marks.
+ **
+ ** The copies may be limited to a given rate, so that they do not take
+ ** the bandwidth of the shared file system from the other processes.
+ ** Without pthreads, the files are copied as soon as the mark is queued.
+ **/
+class File_drainer {
+public:
+  /// The files to be copied, as pairs of the local file and the copy.
+  typedef std::vector<std::pair<std::string, std::string> > Copies;
+
+  /** Add the files to be copied for a mark, after waiting for the writes
+   *  before it. Called on the thread of the drainer.
+   */
+  typedef void (*Collect)(void* arg, long long upto, Copies& copies);
+
+  /** Remove the local files given, unless they were written again, and
+   *  end what Collect started, once the copies of a mark are done.
+   */
+  typedef void (*Finish)(void* arg, const std::vector<std::string>& old);
+
+  File_drainer();
+
+  /// Wait for the queued copies and stop the thread.
+  ~File_drainer();
+
+  /// Set where the marks get their files.
+  void set_source(Collect collect, Finish finish, void* arg);
+
+  /// Limit the copies to the given rate in MB/s, or not at all if 0.
+  void set_rate(int mb_per_s);
+
+  /** Keep the local files of the last k marks reached, and remove the
+   *  older ones once a mark is reached, or keep them all if k is 0.
+   */
+  void set_keep(int k);
+
+  /** Queue a mark, and return its number.
+   *
+   * \param upto The last write whose files are copied, passed to Collect.
+   */
+  int mark(long long upto);
+
+  /// Return the number of the last mark reached, or 0.
+  int drained();
+
+  /// Wait until all the queued copies have finished.
+  void wait();
+
+protected:
+  struct Task {
+    int mark;              ///< The number of the mark.
+    long long upto;        ///< The last write it covers.
+  };
+
+  /// Collect and copy the files of a mark, at the given rate in MB/s.
+  void run(const Task& t, int rate, int keep);
+
+  /// Copy a file and its index, trying a few times.
+  static bool drain_file(const std::string& src, const std::string& dst,
+                         int rate);
+
+  /// Copy a file at the given rate in MB/s.
+  static bool copy_file(const std::string& src, const std::string& dst,
+                        int rate);
+
+#ifdef USE_PTHREADS
+  /// Entry point of the thread.
+  static void* entry(void* drainer);
+
+  Mutex _mutex;
+  Condition _queued;     ///< Signaled when a task is queued or on stop.
+  Condition _idle;       ///< Signaled when no task is pending.
+  pthread_t _thread;
+  bool _running;
+  bool _stopping;
+#endif // USE_PTHREADS
+  std::list<Task> _tasks;
+  Collect _collect;
+  Finish _finish;
+  void* _arg;
+  int _pending;          ///< Tasks queued or running.
+  int _rate;
+  int _keep;
+  int _marks;            ///< Number of the last mark queued.
+  int _drained;          ///< Number of the last mark reached.
+  Copies _retry;         ///< The copies that failed, for the next mark.
+  /// The local files copied by the marks whose files are kept.
+  std::list<std::vector<std::string> > _copied;
+
+private:
+  File_drainer(const File_drainer&);
+  File_drainer& operator=(const File_drainer&);
+};
+
+#endif // !defined(_ROCOUT_DRAIN_H)
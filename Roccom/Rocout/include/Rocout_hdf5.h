@@ -0,0 +1,58 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file Rocout_hdf5.h
+ *  Declaration of Rocout HDF5 routines.
+ */
+#ifndef _ROCOUT_HDF5_H
+#define _ROCOUT_HDF5_H
+
+#include "roccom.h"
+#include <string>
+
+/**
+ ** Write the data for the given attribute of all panes to a shared file.
+ **
+ ** Write the given attribute to file using the HDF5 layout described in
+ ** rocin_hdf5.h.  The attribute may be a "mesh", "all" or some other
+ ** predefined attribute.  This is a collective call over the communicator:
+ ** all processes write the items of their panes into the same datasets,
+ ** with collective MPI-IO if HDF5 was built for parallel access, or else
+ ** one process after another.
+ **
+ ** \param fname The name of the shared datafile. (Input)
+ ** \param mfile The name of the optional mesh datafile. (Input)
+ ** \param attr The attribute to write out. (Input)
+ ** \param material The name of the material. (Input)
+ ** \param timelevel The simulation time for this data. (Input)
+ ** \param comm The communicator of the processes sharing the file. (Input)
+ ** \param pane_id If positive, the only local pane to write. (Input)
+ ** \param errorhandle "ignore", "warn", or "abort" on errors.
+ ** \param mode Write == 0, append == 1. (Input)
+ **/
+void write_attr_HDF5(const std::string& fname, const std::string& mfile,
+                     const COM::Attribute* attr, const char* material,
+                     const char* timelevel, MPI_Comm comm, int pane_id,
+                     const std::string& errorhandle, int mode);
+
+#endif // !defined(_ROCOUT_HDF5_H)
@@ -0,0 +1,130 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file Rocout_native.h
+ *  Declaration of the Rocout routine for the native binary format.
+ */
+#ifndef _ROCOUT_NATIVE_H
+#define _ROCOUT_NATIVE_H
+
+#include "roccom.h"
+#include <map>
+#include <string>
+#ifdef USE_PTHREADS
+#include "Sync.h"
+#endif // USE_PTHREADS
+
+/// Statistics of the compression of the arrays written.
+struct Native_stats {
+  Native_stats() : raw(0), stored(0), seconds(0) {}
+
+  double raw;      ///< Bytes of the arrays before compression.
+  double stored;   ///< Bytes of the arrays in the files.
+  double seconds;  ///< Time spent compressing and writing.
+};
+
+/**
+ ** Where the arrays of the previous dumps are stored, for incremental
+ ** dumps. An array whose size and 128-bit content hash match those of
+ ** the last dump of the same array, whose block is still in its file, is
+ ** written as a reference to that data, for at most limit dumps in a row,
+ ** after which it is written again. Only the last limit+1 dumps are thus
+ ** needed to read the latest one. With verify on, the stored data is also
+ ** read back and compared with the array before it is referenced.
+ **/
+class Native_history {
+public:
+  /// Location of the stored data of an array.
+  struct Entry {
+    Entry() : raw(0), block(0), stamp(0), offset(0), nbytes(0), codec(0),
+              refs(0) { hash[0] = hash[1] = 0; }
+
+    unsigned long long hash[2];  ///< 128-bit hash of the uncompressed data.
+    long long raw;             ///< Size of the uncompressed data.
+    std::string file;          ///< File holding the data.
+    long long block;           ///< Offset of the block holding the data.
+    unsigned long long stamp;  ///< Stamp of that block.
+    long long offset;          ///< Offset of the data in the file.
+    long long nbytes;          ///< Size of the data in the file.
+    int codec;
+    int refs;                  ///< References written since.
+  };
+
+  Native_history() : _limit(0), _verify(false) {}
+
+  /// Set the number of references to the same data, 0 to disable.
+  void set_limit(int limit) { _limit = limit; }
+  int limit() const { return _limit; }
+
+  /// Whether to compare the stored data before referencing it.
+  void set_verify(bool verify) { _verify = verify; }
+  bool verify() const { return _verify; }
+
+  /** Find the stored data of an array with the given hash and size that
+   *  may still be referenced, and count one more reference to it. Data
+   *  in the file being truncated is not referenced.
+   */
+  bool reference(const std::string& key, const unsigned long long hash[2],
+                 long long raw, const std::string& truncated, Entry& e);
+
+  /// Record where an array has been stored.
+  void record(const std::string& key, const Entry& e);
+
+private:
+  int _limit;
+  bool _verify;
+  std::map<std::string, Entry> _entries;
+#ifdef USE_PTHREADS
+  Mutex _lock;   ///< The writer threads may use the history concurrently.
+#endif // USE_PTHREADS
+};
+
+/**
+ ** Write the data for the given attribute of a pane to a native file.
+ **
+ ** Write the given attribute as one block of the layout described in
+ ** rocin_native.h, i.e. a small header followed by the raw arrays,
+ ** which Rocin can map into memory.  The attribute may be a "mesh",
+ ** "all" or some other predefined attribute, as for write_attr_HDF4.
+ **
+ ** \param fname The name of the main datafile. (Input)
+ ** \param mfile The name of the optional mesh datafile. (Input)
+ ** \param attr The attribute to write out. (Input)
+ ** \param material The name of the material. (Input)
+ ** \param timelevel The simulation time for this data. (Input)
+ ** \param pane_id The pane to write. (Input)
+ ** \param errorhandle "ignore", "warn", or "abort" on errors.
+ ** \param mode Write == 0, append == 1. (Input)
+ ** \param compress "off", "zlib" or "shuffle-zlib". (Input)
+ ** \param stats Statistics to add to, or NULL. (Output)
+ ** \param history The previous dumps, for an incremental dump, or NULL.
+ **/
+void write_attr_native(const std::string& fname, const std::string& mfile,
+                       const COM::Attribute* attr, const char* material,
+                       const char* timelevel, int pane_id,
+                       const std::string& errorhandle, int mode,
+                       const std::string& compress = "off",
+                       Native_stats* stats = NULL,
+                       Native_history* history = NULL);
+
+#endif // !defined(_ROCOUT_NATIVE_H)
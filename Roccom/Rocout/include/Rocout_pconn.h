@@ -0,0 +1,49 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+/** \file Rocout_pconn.h
+ *  Declaration of the hook with which Rocout refreshes the fingerprints
+ *  of pconn before writing them.
+ */
+#ifndef _ROCOUT_PCONN_H
+#define _ROCOUT_PCONN_H
+
+#include "roccom_devel.h"
+
+/**
+ ** Rocout writes the panel attribute "pconn_fingerprint" along with pconn,
+ ** so that Rocmap can reuse pconn read from a restart file. Since the
+ ** fingerprints are defined by Rocmap, which depends on Rocout, Rocmap 
+ ** registers the function that recomputes them for the local panes of 
+ ** the window of pconn. Rocout calls it before writing a window with 
+ ** fingerprints, so that the values written describe the mesh and pconn 
+ ** being written rather than those at the time of stamping.
+ **/
+typedef void (*Rocout_pconn_stamp)(const COM::Attribute* pconn);
+
+/// Register the function that recomputes the fingerprints, or NULL.
+void Rocout_set_pconn_stamp(Rocout_pconn_stamp f);
+
+/// Obtain the function that recomputes the fingerprints, or NULL.
+Rocout_pconn_stamp Rocout_get_pconn_stamp();
+
+#endif // !defined(_ROCOUT_PCONN_H)
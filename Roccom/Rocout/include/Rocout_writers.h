@@ -0,0 +1,155 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+/** \file Rocout_writers.h
+ *  Declaration of the pool of threads writing files in the background.
+ */
+#ifndef _ROCOUT_WRITERS_H
+#define _ROCOUT_WRITERS_H
+
+#include <list>
+#include <set>
+#include <string>
+#include <vector>
+#include <pthread.h>
+#include "Sync.h"
+
+class Pane_stage;
+
+/**
+ ** A fixed number of threads writing files in the background.
+ **
+ ** A write first takes one of a fixed number of staging buffers, into
+ ** which the caller copies the data to be written, and then goes into the
+ ** queue of the threads. The buffer returns to the pool when the write
+ ** has finished. If all buffers are in use, taking one waits for a write
+ ** to finish, so the memory held by pending writes is bounded and a
+ ** simulation that dumps faster than the disk is slowed down to its pace.
+ ** With the default of two buffers, one dump can be staged while the
+ ** previous one is written.
+ **
+ ** Every write names the files it writes. The writes of a file are done
+ ** one at a time in the order of submission, while the writes of other
+ ** files go on in the other threads.
+ **
+ ** The buffers of finished writes are released by acquire() and wait()
+ ** rather than by the threads, so that their windows are deleted by the
+ ** thread submitting the writes, like all the other Roccom objects.
+ **/
+class Writer_pool {
+public:
+  /// A write, which gets its argument and deletes it.
+  typedef void* (*Job)(void*);
+
+  Writer_pool();
+
+  /// Wait for the pending writes and stop the threads.
+  ~Writer_pool();
+
+  /** Set the numbers of threads and staging buffers. If they change,
+   *  wait for the pending writes first.
+   */
+  void configure(int nthreads, int nbuffers);
+
+  /// Take a free staging buffer, waiting for a write to finish if none is.
+  /// Must be called by the thread submitting the writes.
+  Pane_stage* acquire();
+
+  /** Queue a write from a buffer taken before, which is freed after it.
+   *
+   * \param files The files written, which no other write may use until
+   *        this one has finished.
+   * \return The number of the write, which is submitted() + 1 before.
+   */
+  long long submit(Job job, void* arg, Pane_stage* stage,
+                   const std::vector<std::string>& files);
+
+  /// Return the number of the last write queued, or 0.
+  long long submitted();
+
+  /// Wait until all the queued writes have finished, and release their
+  /// buffers. Must be called by the thread submitting the writes.
+  void wait();
+
+  /// Wait until the writes numbered up to seq have finished.
+  void wait_for(long long seq);
+
+  /** Keep the writes of the given files from starting, after waiting for
+   *  those running, e.g. to read the files, until they are released.
+   */
+  void hold(const std::vector<std::string>& files);
+
+  /// Let the writes of files held before go on.
+  void release(const std::vector<std::string>& files);
+
+private:
+  struct Task {
+    Job job;
+    void* arg;
+    long long seq;
+    Pane_stage* stage;
+    std::vector<std::string> files;
+  };
+
+  /// Entry point of the threads.
+  static void* entry(void* pool);
+
+  /// The first queued task whose files are not used by a running task or
+  /// by a task queued before it, or _tasks.end() if none.
+  std::list<Task>::iterator next_task();
+
+  /// Release the buffers of the finished writes and make them free.
+  void release_finished();
+
+  /// Start the threads.
+  void start();
+
+  /// Stop the threads once the queue is empty.
+  void stop();
+
+  Mutex _mutex;
+  Condition _queued;     ///< Signaled when a task is queued or finished,
+                         ///< or on stop.
+  Condition _freed;      ///< Signaled when a buffer is freed.
+  Condition _idle;       ///< Signaled when no task is pending.
+  Condition _done;       ///< Signaled when a task finishes or files are
+                         ///< released.
+  std::list<Task> _tasks;
+  std::set<std::string> _busy;       ///< Files of the running tasks, or
+                                     ///< held.
+  std::set<long long> _seqs;         ///< Numbers of the pending tasks.
+  std::vector<Pane_stage*> _stages;  ///< All the buffers.
+  std::vector<Pane_stage*> _free;    ///< The free buffers.
+  std::vector<Pane_stage*> _finished;  ///< Buffers of finished writes, to
+                                       ///< be released.
+  std::vector<pthread_t> _threads;
+  int _nthreads;
+  int _pending;          ///< Tasks queued or running.
+  long long _submitted;  ///< Number of the last task queued.
+  bool _stopping;
+
+  Writer_pool(const Writer_pool&);
+  Writer_pool& operator=(const Writer_pool&);
+};
+
+#endif // !defined(_ROCOUT_WRITERS_H)
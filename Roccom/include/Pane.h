@@ -95,6 +95,30 @@ public:
   /// Get the ID of the pane.
   int     id() const      { return _id; }
 
+  /** Obtain the generation of the mesh of the pane. It is unique among
+   *  all panes ever created in the process and changes whenever the sizes,
+   *  element connectivity, or pane connectivity of the pane are reset,
+   *  so it can be used to validate data cached for a pane. */
+  unsigned long mesh_generation() const { return _mesh_gen; }
+
+  /// Notify that the mesh of the pane was modified in place.
+  void mesh_changed() { _mesh_gen = next_mesh_generation(); }
+
+  /** Obtain the serial number of the pane, which is unique among all 
+   *  panes ever created in the process and never changes. Along with 
+   *  the address, it identifies the pane in data cached for it, even 
+   *  after the address is reused by another pane. */
+  unsigned long serial() const { return _serial; }
+
+  /// A function to be called with each pane before it is deleted.
+  typedef void (*Deletion_hook)( const Pane*);
+
+  /// Register a function to be called before any pane is deleted.
+  static void add_deletion_hook( Deletion_hook h);
+
+  /// Unregister a function registered with add_deletion_hook.
+  static void remove_deletion_hook( Deletion_hook h);
+
   /// Dimension of the pane.
   int  dimension() const 
   { return _cnct_set.empty()?0:_cnct_set[0]->dimension(); }
@@ -315,6 +339,15 @@ protected:
   Attr_set    _attr_set;   ///< Set of attributes
   Cnct_set    _cnct_set;   ///< Set of element connectivity
   bool        _ignore_ghost;  ///< Whether the ghosts were ignored
+  unsigned long _mesh_gen;    ///< Generation of the mesh
+  unsigned long _serial;      ///< Serial number of the pane
+
+  static unsigned long _last_mesh_gen; ///< Last mesh generation assigned
+
+  /// Assign a new mesh generation. It is atomic, since panes may be 
+  /// modified by concurrent threads (see Rocmap's for_each_pane).
+  static unsigned long next_mesh_generation() 
+  { return __sync_add_and_fetch( &_last_mesh_gen, 1UL); }
 
 private:
 #ifdef DOXYGEN
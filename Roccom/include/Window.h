@@ -93,6 +93,27 @@ public:
 
   /// Obtain the communicator of the window.
   MPI_Comm get_communicator() const { return _comm; }
+
+  /** Obtain the serial number of the window, which is unique among all
+   *  windows ever created in the process. Along with the name, it
+   *  identifies the window in data cached for it, even after a window
+   *  of the same name is created again. */
+  unsigned long serial() const { return _serial; }
+
+  /// A function to be called with each window before it is deleted.
+  typedef void (*Deletion_hook)( const Window*);
+
+  /// Register a function to be called before any window is deleted,
+  /// by COM_delete_window or by its destructor.
+  static void add_deletion_hook( Deletion_hook h);
+
+  /// Unregister a function registered with add_deletion_hook.
+  static void remove_deletion_hook( Deletion_hook h);
+
+  /// Call the deletion hooks for the window, only the first time it is
+  /// called. COM_delete_window calls it when it removes the window from
+  /// Roccom, and the destructor calls it otherwise.
+  void call_deletion_hooks() const;
   //\}
 
   /** \name Function and data management
@@ -382,8 +403,11 @@ protected:
   int          _last_id;     ///< The last used attribute index. The next
                              ///< available one is _last_id+1.
   MPI_Comm     _comm;        ///< the MPI communicator of the window.
+  unsigned long _serial;     ///< Serial number of the window.
+  static unsigned long _last_serial; ///< Last serial number assigned.
   enum { STATUS_SHRUNK, STATUS_CHANGED, STATUS_NOCHANGE };
   int          _status;      ///< Status of the window.
+  mutable bool _hooks_called; ///< Whether the deletion hooks were called.
 
 private:
   // Disable the following two functions (they are dangerous)
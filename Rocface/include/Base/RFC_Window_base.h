@@ -103,6 +103,7 @@ struct Face_ID {
 };
 
 class RFC_Window_base;
+class Overlay_parallel;
 using MAP::Element_node_enumerator;
 
 template < class _Pane> class RFC_Window_derived;
@@ -160,6 +161,7 @@ public:
 
   friend class RFC_Window_base;
   template <class _Pane> friend class RFC_Window_derived;
+  friend class Overlay_parallel;
 
   //! A local ID of an edge.
   /*! Each edge is identified by a pair of integers: the local face id and
@@ -596,6 +598,12 @@ public:
   //! Write out panes in native binary format or using Rocout.
   void write_sdv( const char* prefix, const char *format=NULL) const;
 
+  //! Write the subdivision of a local pane in native binary format.
+  void pack_sdv( int pane_id, std::ostream &os) const;
+
+  //! Read the subdivision of a local pane written by pack_sdv.
+  void unpack_sdv( int pane_id, std::istream &is);
+
   //! Build the pane connectivity table.
   void build_pc_tables();
 
@@ -75,11 +75,20 @@ public:
   ~Overlay();
 
   // This function is the main interface for the overlay algorithm. 
+  // Return 0 on success, or 1 if the overlay of a region failed.
   int overlay();
 
   // Set tolerance for snapping vertices.
   void set_tolerance( double tol);
 
+  // Enable or disable the check that the bounding boxes of the two 
+  // meshes agree. It must be disabled when overlaying regions cut out
+  // of larger meshes, whose borders need not match. Without the check,
+  // overlay() returns 1 instead of aborting when the meshes are found
+  // to be inconsistent, so that the caller can recompute the overlay 
+  // in a larger region.
+  void set_bbox_check( bool chk) { check_bbox = chk; }
+
   // Interfaces for the data transfer algorithms
   RFC_Window_overlay *get_rfc_window( const COM::Window *w) 
   { return ( B->base() == w) ? B : G; }
@@ -126,8 +135,10 @@ protected:
   // The initialization for the overlay algorithm. It locates the
   //     green parent of a blue vertex and create an inode for it.
   //     This initialization step takes linear time.
-  // Returns NULL if unsuccessful. Otherwise, creates a new INode.
-  INode *overlay_init();
+  // Sets seed to NULL if all the blue halfedges are marked. Otherwise, 
+  //     creates a new INode. Returns 1 if the green parent cannot be 
+  //     located in a region overlay.
+  int overlay_init( INode **seed);
   // Helper for overlay_init which computes the parent of a point x
   void get_green_parent( const Vertex *v,
 			 const Halfedge *b,
@@ -136,7 +147,8 @@ protected:
 			 Point_2      *nc);
 
   // This function ensures the consistency of the green parent of x.
-  void insert_node_in_blue_edge( INode &x, Halfedge *b);
+  // The helpers of the steps return 1 if a region overlay failed.
+  int insert_node_in_blue_edge( INode &x, Halfedge *b);
 
   // This subroutine is step 1 of the algorithm. It determines the 
   //    associates of the vertices of the blue mesh in the green mesh.
@@ -144,12 +156,12 @@ protected:
   //    edges. These intersections   are stored in the lists associated 
   //    with the blue edges. At input, x is an inode corresponding to 
   //    a blue vertex.
-  void intersect_blue_with_green();
+  int intersect_blue_with_green();
 
   //  Sort the intersection points with respect to green edges and
   //       computes the projection of green vertices in B.
   void sort_on_green_edges();
-  void associate_green_vertices();
+  int associate_green_vertices();
 
   // The helper for sort_on_green_edges. It inserts a node v into the green
   // edge v->green_halfedge(). Tag is for marking the buckets. We assume 
@@ -158,11 +170,14 @@ protected:
 
   // Helper for associate_green_vertices, which determines the parent
   //   of g->destination() from the object containing (b0,t0).
-  void
+  int
   project_adjacent_green_vertices( const INode *, Halfedge *);
 
   bool verify_inode( const INode *i);
 
+  // Destroy the partial overlay after a step failed, and return 1.
+  int abandon_overlay();
+
   // Helpers for determine_edge_parents.
   Host_face 
   get_edge_parent( const INode &i0, const INode &i1, 
@@ -218,7 +233,7 @@ protected:
 	    const Halfedge *e2, const Parent_type t2) const;
 
   // ===== Following subroutines are for matching 0-dimensional features
-  void match_features_0();
+  int match_features_0();
   INode* project_next_vertex( Halfedge *, Halfedge *);
 
   int count_edges( const Halfedge *e) const {
@@ -286,6 +301,7 @@ protected:
   bool                 is_opposite;
   bool                 verbose;
   bool                 verbose2;
+  bool                 check_bbox;
   std::string          out_pre; // Output prefix
 
   Real eps_e;
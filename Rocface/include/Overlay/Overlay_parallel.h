@@ -0,0 +1,151 @@
+/* *******************************************************************
+ * Rocstar Simulation Suite                                          *
+ * Copyright@2015, Illinois Rocstar LLC. All rights reserved.        *
+ *                                                                   *
+ * Illinois Rocstar LLC                                              *
+ * Champaign, IL                                                     *
+ * www.illinoisrocstar.com                                           *
+ * sales@illinoisrocstar.com                                         *
+ *                                                                   *
+ * License: See LICENSE file in top level of distribution package or *
+ * http://opensource.org/licenses/NCSA                               *
+ *********************************************************************/
+/* *******************************************************************
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,   *
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES   *
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND          *
+ * NONINFRINGEMENT.  IN NO EVENT SHALL THE CONTRIBUTORS OR           *
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER       *
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE,   *
+ * ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE    *
+ * USE OR OTHER DEALINGS WITH THE SOFTWARE.                          *
+ *********************************************************************/
+
+//==========================================================
+// The header file for the class Overlay_parallel, which computes
+// the overlay of two windows distributed over the processes of a
+// communicator by partitioning them into regions.
+//
+// See also: Overlay_parallel.C.
+//==========================================================
+
+#ifndef RFC_OVERLAY_PARALLEL_H
+#define RFC_OVERLAY_PARALLEL_H
+
+#include "rfc_basic.h"
+#include "RFC_Window_base.h"
+#include <iostream>
+#include <string>
+#include <vector>
+
+RFC_BEGIN_NAME_SPACE
+
+class RFC_Window_transfer;
+class RFC_Pane_transfer;
+
+// The panes of the blue window are partitioned into regions by recursive
+// coordinate bisection (RCB) of the centers of their bounding boxes, and
+// each green pane is assigned to the region on the side of its center.
+// Region r is computed on process r: it collects the panes of both 
+// windows within a halo of the panes it owns and overlays them with the
+// serial algorithm. The subdivisions of the blue panes are then taken 
+// from the regions owning them, and the subdivision of each green pane 
+// is assembled from the subfaces of all the blue panes it intersects, 
+// identifying the subnodes by their parent features in both windows. 
+// The result is checked against the overlay computed by the region 
+// owning the green pane.
+class Overlay_parallel {
+public:
+  // Constructor. The windows w1 and w2 are the blue and green windows,
+  // and the temporary windows of the regions are named after them with
+  // the given prefix.
+  Overlay_parallel( const COM::Window *w1, const COM::Window *w2, 
+		    MPI_Comm comm, const std::string &prefix);
+
+  // Set tolerance for snapping vertices.
+  void set_tolerance( double tol) { _tol = tol; }
+
+  // Set the width of the halos around the regions, in multiples of the
+  // maximum edge length of the meshes (6 by default).
+  void set_halo( double h) { _halo = h; }
+
+  // Compute the overlay in at most nregions regions and store the 
+  // subdivisions of the local panes in bw and gw. Return 0 on success,
+  // or 1 if the overlay of a region failed or the regions do not match,
+  // in which case bw and gw are left untouched.
+  int overlay( int nregions, RFC_Window_base *bw, RFC_Window_base *gw);
+
+  // Write the mesh of a pane into a stream: the pane ID, the coordinates,
+  // and the connectivity tables.
+  static void pack_mesh( const COM::Pane *p, std::ostream &os);
+
+  // Create the panes written by pack_mesh in a window.
+  static void unpack_meshes( const std::string &wname, std::istream &is, 
+			     std::vector<int> &pane_ids);
+
+protected:
+  // Size, bounding box and owner of a pane.
+  struct Pane_info {
+    int     id, nfaces, owner;
+    double  bbox[6];
+    double center( int d) const { return 0.5*(bbox[d]+bbox[d+3]); }
+  };
+
+  // A subface of a blue pane and its counterpart in a green pane, with 
+  // the parents of its subnodes in both windows.
+  struct Subface_record;
+
+  // The counterpart of a blue subface after the green pane is assembled.
+  struct Counterpart_record;
+
+  // Collect the pane information of a window from all the processes.
+  void gather_panes( const COM::Window *w, std::vector<Pane_info> &ps) const;
+
+  // Partition the blue panes bs[bi] into nparts regions starting from
+  // first, and assign the green panes gs[gi] to them.
+  static void rcb( const std::vector<Pane_info> &bs, 
+		   const std::vector<int> &bi,
+		   const std::vector<Pane_info> &gs, 
+		   const std::vector<int> &gi,
+		   int nparts, int first, 
+		   std::vector<int> &bregion, std::vector<int> &gregion);
+
+  // Send to each region the panes of a window it needs, and create them 
+  // in a window on the process of the region.
+  void distribute_panes( const COM::Window *w, 
+			 const std::vector<Pane_info> &ps,
+			 const std::vector< std::vector<char> > &needed,
+			 const std::string &wname) const;
+
+  // Exchange byte streams between all the processes.
+  void exchange( const std::vector<std::string> &out, 
+		 std::vector<std::string> &in) const;
+
+  // Write the parent feature of a subnode into key[0..4]. If w is not 
+  // NULL, the nodes are identified by their primary copies in w.
+  static void parent_key( RFC_Window_transfer *w, RFC_Pane_transfer *p,
+			  int sn, int *key);
+
+  // Assemble the subdivision of a green pane from the subfaces of the 
+  // blue panes in [first,last), sorted by their parent faces, and append
+  // the counterparts of the blue subfaces to cps. The subnodes keep the
+  // IDs, parents and natural coordinates computed in place, with the blue
+  // window rb of the region. Return the number of differences from the
+  // subdivision computed in place, in which case the pane is unchanged.
+  static int assemble_green_pane( RFC_Window_transfer *rb,
+				  RFC_Pane_transfer &q, 
+				  const Subface_record *first,
+				  const Subface_record *last,
+				  std::vector<Counterpart_record> &cps);
+
+private:
+  const COM::Window *_w1, *_w2;
+  MPI_Comm           _comm;
+  std::string        _prefix;
+  double             _tol;
+  double             _halo;
+};
+
+RFC_END_NAME_SPACE
+
+#endif
@@ -53,10 +53,11 @@ public:
   typedef std::map<std::string, RFC_Window_transfer*>  TRS_Windows;
 
   struct Control_parameters {
-    Control_parameters() : verb(0), snap(1.e-3) {}
+    Control_parameters() : verb(0), snap(1.e-3), halo(6) {}
 
     int    verb;
     double snap;
+    double halo; // Halo width of the regions of overlay_distributed
   };
 
 public:
@@ -69,6 +70,10 @@ public:
   // set verbose level 
   void set_verbose( int *verbose);
 
+  // set the halo width of the regions of overlay_distributed, in 
+  // multiples of the maximum edge length
+  void set_halo( double *halo);
+
   // read Rocface control file
   void read_control_file( const char *fname);
 
@@ -78,6 +83,12 @@ public:
 		const MPI_Comm *_comm=NULL,
 		const char *path=NULL);
   
+  // Construct the overlay of two meshes distributed over the processes
+  // of comm in parallel, without writing or reading any files.
+  void overlay_distributed( const COM::Attribute *mesh1, 
+			    const COM::Attribute *mesh2,
+			    const MPI_Comm *comm=NULL);
+
   // Remove the overlay.
   void clear_overlay( const char *mesh1, 
 		      const char *mesh2);
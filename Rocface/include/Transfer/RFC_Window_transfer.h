@@ -135,9 +135,7 @@ public:
   typedef RFC_Window_transfer                           Self;
   typedef RFC_Window_derived<RFC_Pane_transfer>         Base;
 
-  RFC_Window_transfer( COM::Window *b, int color, 
-		       MPI_Comm com, const char *pre=NULL, 
-		       const char *format=NULL);
+  RFC_Window_transfer( COM::Window *b, int color, MPI_Comm com);
   virtual ~RFC_Window_transfer();
 
   RFC_Pane_transfer &pane( const int pid);
@@ -194,6 +192,11 @@ public:
   { return COMMPI_Initialized()?COMMPI_Comm_size( _comm):1; }
 
   void wait_all( int n, MPI_Request *requests);
+
+  //! Send out[i] to process i of comm and receive in[i] from it. The 
+  //! strings may hold more than 2 GB, which then go in pieces.
+  static void exchange_bytes( const std::vector<std::string> &out,
+			      std::vector<std::string> &in, MPI_Comm comm);
   void wait_any( int n, MPI_Request *requests, int *index, MPI_Status *stat=NULL);
 
   void allreduce( Array_n &arr, MPI_Op op) const
@@ -215,7 +218,7 @@ private:
   }
 
   void init_send_buffer( int pane_id, int to_rank);
-  void init_recv_buffer( int pane_id, int from_rank);
+  void init_recv_buffer( int pane_id, int from_rank, std::istream &is);
 
 private:
   int                                            _buf_dim;
@@ -226,8 +229,6 @@ private:
   bool                                           _replicated;
 
   std::set< std::pair<int, RFC_Pane_transfer*> > _panes_to_send; //<to_rank, p>
-  const std::string                              _prefix;
-  const int                                      _IO_format;
 };
 
 //================================================================
@@ -115,6 +115,11 @@ protected:
 
   std::string restartInfo;
 
+  // Dumps whose files are still being drained from node-local storage.
+  // They are recorded in restartInfo once every process has drained them.
+  struct Pending_dump { int mark; int step; double time; };
+  vector<Pending_dump> undrained;
+
     // compute integrals
   int overwrite_integ;
   std::string integFname;
@@ -123,6 +128,7 @@ protected:
   std::string distFname;
 private:
   void baseInit();
+  void append_restart_info(double CurrentTime, int iStep);
 public:
   /// Constructor. Derived class will add actions for the coupling scheme
   Coupling(const char *coupl_name, const char *name, Control_parameters *p, const RocmanControl_parameters *mp);
@@ -186,6 +192,10 @@ public:
   void read_restart_info();
   void write_restart_info(double CurrentTime, int iStep);
 
+  /// Record the dumps that all processes have drained in restartInfo.
+  /// If wait is true, first wait for all pending drains to finish.
+  void record_drained_dumps(bool wait);
+
   void restart_at_time(double t, int step);
   virtual void reload_rocface(const RocmanControl_parameters *param) {}
 
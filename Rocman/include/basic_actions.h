@@ -117,7 +117,7 @@ class SurfDiver: public Action {
   std::string fluid_mesh_str, solid_mesh_str;
   int fluid_mesh, solid_mesh;
   int RFC_transfer, RFC_interpolate, RFC_readcntr, RFC_overlay; 
-  int RFC_write, RFC_read;
+  int RFC_write, RFC_read, RFC_overlay_dist;
 };
 
 // run surfdiver if overlay mesh is missing
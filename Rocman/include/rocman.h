@@ -85,6 +85,7 @@ public:
   int     PROPCON_ndiv;         // number of divisions for propagation constraints (Rocon)
   char    async_in;		// 
   char    async_out;
+  char    dump_overlay_meshes; // also dump the meshes overlaid by SurfDiver
 
   int     remeshed;
 public:
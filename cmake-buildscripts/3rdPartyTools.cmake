@@ -12,7 +12,9 @@ libm
 mkl
 hdf4
 pthread
-cgns)
+cgns
+hdf5
+zlib)
 
 set(3RDPARTY_TOOL_USES
 "for fundamental linear algebra calculations"                                     
@@ -21,7 +23,9 @@ set(3RDPARTY_TOOL_USES
 "alternate implementation of lapack and blas that is tuned for speed"
 "used for saving array data to files"
 "POSIX threading library"
-"used as an optional output format for fluid data")                                                
+"used as an optional output format for fluid data"
+"used for the shared-file parallel output format"
+"used to compress the native output format")                                                
 
 
 #sets a tool to external, internal, or disabled
@@ -251,6 +255,37 @@ if(NEED_cgns)
 	endif()
 endif()
 
+#------------------------------------------------------------------------------
+#  HDF5
+#------------------------------------------------------------------------------ 
+
+if(NEED_hdf5)
+	find_package(HDF5 COMPONENTS C)
+	
+	if(HDF5_FOUND)
+		set_3rdparty(hdf5 EXTERNAL)
+		if(NOT HDF5_IS_PARALLEL)
+			message(WARNING "HDF5 was built without parallel I/O support.  The processes will write shared HDF5 files one after another.")
+		endif()
+	else()
+		set_3rdparty(hdf5 DISABLED)
+	endif()
+endif()
+
+#------------------------------------------------------------------------------
+#  zlib
+#------------------------------------------------------------------------------ 
+
+if(NEED_zlib)
+	find_package(ZLIB)
+	
+	if(ZLIB_FOUND)
+		set_3rdparty(zlib EXTERNAL)
+	else()
+		set_3rdparty(zlib DISABLED)
+	endif()
+endif()
+
 # Apply user overrides
 # -------------------------------------------------------------------------------------------------------------------------------------------------------
 
@@ -402,4 +437,18 @@ endif()
 #------------------------------------------------------------------------------ 
 if(cgns_EXTERNAL)	
 	import_libraries(cgns LIBRARIES ${CGNS_LIBRARIES} INCLUDES ${CGNS_INCLUDE_DIRS})
+endif()
+
+#------------------------------------------------------------------------------
+#  HDF5
+#------------------------------------------------------------------------------ 
+if(hdf5_EXTERNAL)	
+	import_libraries(hdf5 LIBRARIES ${HDF5_C_LIBRARIES} INCLUDES ${HDF5_C_INCLUDE_DIRS})
+endif()
+
+#------------------------------------------------------------------------------
+#  zlib
+#------------------------------------------------------------------------------ 
+if(zlib_EXTERNAL)	
+	import_libraries(zlib LIBRARIES ${ZLIB_LIBRARIES} INCLUDES ${ZLIB_INCLUDE_DIRS})
 endif()
\ No newline at end of file